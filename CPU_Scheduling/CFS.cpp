@@ -0,0 +1,398 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <set>
+#include <queue>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <climits>
+using namespace std;
+
+// Completely Fair Scheduler (Linux CFS) simulation next to round robin, on the same traces.
+//   - every task has a vruntime: CPU time it got, scaled by 1024 / weight(nice)
+//   - runnable tasks sit in a red-black tree ordered by vruntime; the leftmost one runs
+//   - slice = sched_latency * weight / total weight, but at least min_granularity
+//   - a task that wakes up is placed near min_vruntime (sleeper fairness): it gets a small
+//     bonus for having slept, but cannot bank hours of sleep as CPU credit
+// Round robin (as in RoundRobin.cpp, but with arrivals and I/O) ignores nice and hands out
+// the same quantum to everybody.
+// Times are in microseconds.
+
+typedef long long ll;
+const ll INF = LLONG_MAX;
+
+// Linux sched_prio_to_weight[]: nice -20 .. 19, every step is ~1.25x, nice 0 = 1024
+const int prio_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+    9548,  7620,  6100,  4904,  3906,
+    3121,  2501,  1991,  1586,  1277,
+    1024,  820,   655,   526,   423,
+    335,   272,   215,   172,   137,
+    110,   87,    70,    56,    45,
+    36,    29,    23,    18,    15,
+};
+const ll NICE_0_LOAD = 1024;
+
+ll sched_latency = 6000;    // 6 ms: every runnable task should run once in this period
+ll min_granularity = 750;   // 0.75 ms: shortest slice
+ll wakeup_granularity = 1000;
+
+struct Task
+{
+    ll arrival;
+    ll burst;     // total CPU time needed
+    ll chunk;     // runs this long, then sleeps (I/O); chunk >= burst = CPU bound
+    ll sleep;
+    int nice;
+};
+
+// Per-task bookkeeping during a simulation
+struct State
+{
+    ll left, chunk_left;
+    ll vruntime = 0;
+    ll enqueued_at = 0;
+    ll first_run = -1, finish = -1;
+    ll cpu = 0, waited = 0;
+    bool woken = true;  // current wait started with an arrival / wakeup
+};
+
+// ---------------- Policies ----------------
+
+struct RoundRobin
+{
+    ll qt;
+    deque<int> ready;
+
+    RoundRobin(ll qt) : qt(qt) {}
+
+    void enqueue(vector<State> &, int t, bool) { ready.push_back(t); }
+    bool empty() { return ready.empty(); }
+    int pick(vector<State> &)
+    {
+        int t = ready.front();
+        ready.pop_front();
+        return t;
+    }
+    ll slice(vector<State> &, int) { return qt; }
+    void account(vector<State> &, int, ll) {}
+    void dequeue(int) {}
+    bool wakeup_preempt(vector<State> &, int, int) { return false; }
+};
+
+struct Cfs
+{
+    const vector<Task> &tasks;
+    // std::set is a red-black tree; libstdc++ keeps a pointer to the leftmost node in the
+    // tree header, so begin() is O(1) - the same trick as the kernel's rb_root_cached.
+    set<pair<ll, int>> tree;
+    ll min_vruntime = 0;
+    ll total_weight = 0; // of all runnable tasks, including the running one
+    int running = -1;
+
+    Cfs(const vector<Task> &tasks) : tasks(tasks) {}
+
+    ll weight(int t) { return prio_to_weight[tasks[t].nice + 20]; }
+
+    // Scale real time to this task's virtual time
+    ll to_virtual(int t, ll delta) { return delta * NICE_0_LOAD / weight(t); }
+
+    void update_min_vruntime(vector<State> &s)
+    {
+        ll v = INF;
+        if (running >= 0) v = s[running].vruntime;
+        if (!tree.empty()) v = min(v, tree.begin()->first);
+        if (v != INF) min_vruntime = max(min_vruntime, v); // never goes backwards
+    }
+
+    void enqueue(vector<State> &s, int t, bool waking)
+    {
+        if (waking)
+        {
+            if (s[t].first_run < 0 && s[t].cpu == 0)
+                s[t].vruntime = min_vruntime + to_virtual(t, slice(s, t)); // new task: starts one slice behind
+            else
+                s[t].vruntime = max(s[t].vruntime, min_vruntime - sched_latency / 2); // sleeper credit
+            total_weight += weight(t);
+        }
+        if (t == running)
+            running = -1;
+        tree.insert({s[t].vruntime, t});
+    }
+
+    bool empty() { return tree.empty(); }
+
+    int pick(vector<State> &)
+    {
+        int t = tree.begin()->second; // leftmost = smallest vruntime
+        tree.erase(tree.begin());
+        running = t;
+        return t;
+    }
+
+    ll slice(vector<State> &, int t)
+    {
+        ll nr = tree.size() + (running >= 0 ? 1 : 0);
+        ll period = max(sched_latency, nr * min_granularity);
+        ll w = total_weight > 0 ? total_weight : weight(t);
+        return max(min_granularity, period * weight(t) / w);
+    }
+
+    void account(vector<State> &s, int t, ll ran)
+    {
+        s[t].vruntime += to_virtual(t, ran);
+        update_min_vruntime(s);
+    }
+
+    // Task t leaves the run queue (sleeps or exits)
+    void dequeue(int t)
+    {
+        total_weight -= weight(t);
+        if (t == running) running = -1;
+    }
+
+    bool wakeup_preempt(vector<State> &s, int woken, int curr)
+    {
+        return s[curr].vruntime - s[woken].vruntime > to_virtual(woken, wakeup_granularity);
+    }
+};
+
+// ---------------- Event-driven simulation ----------------
+
+struct Stats
+{
+    ll switches = 0, decisions = 0;
+    double avg_wait = 0, avg_tat = 0, avg_response = 0;
+    double wake_p50 = 0, wake_p99 = 0; // wakeup -> running latency
+    double decision_ns = 0;
+    vector<ll> cpu;                    // CPU received per task (for fairness)
+};
+
+double percentile(vector<ll> &v, double p)
+{
+    if (v.empty()) return 0;
+    size_t k = min(v.size() - 1, (size_t)(p / 100.0 * v.size()));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+// Run the trace until every task finished or until 'horizon'
+
+template <class Policy>
+Stats simulate(const vector<Task> &tasks, Policy &policy, ll horizon)
+{
+    int n = tasks.size();
+    vector<State> s(n);
+    for (int i = 0; i < n; i++)
+    {
+        s[i].left = tasks[i].burst;
+        s[i].chunk_left = min(tasks[i].chunk, tasks[i].burst);
+    }
+
+    // Arrivals and wakeups: (time, task)
+    priority_queue<pair<ll, int>, vector<pair<ll, int>>, greater<pair<ll, int>>> events;
+    for (int i = 0; i < n; i++)
+        events.push({tasks[i].arrival, i});
+
+    Stats st;
+    vector<ll> wake_latency;
+    ll now = 0, slice_end = 0;
+    int curr = -1, last = -1, done = 0;
+    auto t0 = chrono::steady_clock::now();
+
+    auto make_ready = [&](int t, bool waking) {
+        s[t].enqueued_at = now;
+        s[t].woken = waking;
+        policy.enqueue(s, t, waking);
+    };
+
+    while (done < n && now < horizon)
+    {
+        if (curr < 0)
+        {
+            if (policy.empty())
+            {
+                if (events.empty()) break;
+                now = max(now, events.top().first);
+            }
+            while (!events.empty() && events.top().first <= now)
+            {
+                make_ready(events.top().second, true);
+                events.pop();
+            }
+            curr = policy.pick(s);
+            st.decisions++;
+            if (curr != last) st.switches++;
+            last = curr;
+
+            ll waited = now - s[curr].enqueued_at;
+            s[curr].waited += waited;
+            if (s[curr].woken) wake_latency.push_back(waited);
+            if (s[curr].first_run < 0) s[curr].first_run = now;
+            slice_end = now + policy.slice(s, curr);
+        }
+
+        // Run until the chunk ends, the slice ends or something wakes up
+        ll next_event = events.empty() ? INF : events.top().first;
+        ll end = min({now + s[curr].chunk_left, slice_end, next_event, horizon});
+        ll ran = end - now;
+        now = end;
+        s[curr].left -= ran;
+        s[curr].chunk_left -= ran;
+        s[curr].cpu += ran;
+        policy.account(s, curr, ran);
+
+        if (s[curr].left == 0)
+        {
+            s[curr].finish = now;
+            policy.dequeue(curr);
+            done++;
+            curr = -1;
+        }
+        else if (s[curr].chunk_left == 0) // blocks for I/O
+        {
+            s[curr].chunk_left = min(tasks[curr].chunk, s[curr].left);
+            events.push({now + tasks[curr].sleep, curr});
+            policy.dequeue(curr);
+            curr = -1;
+        }
+        else if (now >= slice_end) // slice used up -> back into the run queue
+        {
+            make_ready(curr, false);
+            curr = -1;
+        }
+
+        while (!events.empty() && events.top().first <= now)
+        {
+            int t = events.top().second;
+            events.pop();
+            make_ready(t, true);
+            if (curr >= 0 && policy.wakeup_preempt(s, t, curr))
+            {
+                make_ready(curr, false);
+                curr = -1;
+            }
+        }
+    }
+
+    st.decision_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / max(1LL, st.decisions);
+    int finished = 0;
+    for (int i = 0; i < n; i++)
+    {
+        st.cpu.push_back(s[i].cpu);
+        if (s[i].finish < 0) continue;
+        finished++;
+        st.avg_wait += s[i].waited;
+        st.avg_tat += s[i].finish - tasks[i].arrival;
+        st.avg_response += s[i].first_run - tasks[i].arrival;
+    }
+    if (finished)
+    {
+        st.avg_wait /= finished;
+        st.avg_tat /= finished;
+        st.avg_response /= finished;
+    }
+    st.wake_p50 = percentile(wake_latency, 50);
+    st.wake_p99 = percentile(wake_latency, 99);
+    return st;
+}
+
+// ---------------- Traces ----------------
+
+// Mixed server load: CPU-bound batch jobs and interactive tasks that run briefly and sleep
+
+vector<Task> mixed_trace(int n, unsigned seed)
+{
+    mt19937 rng(seed);
+    exponential_distribution<double> gap(1.0 / 25000), burst(1.0 / 20000); // ~85% busy
+    vector<Task> tasks(n);
+    ll t = 0;
+    for (int i = 0; i < n; i++)
+    {
+        t += (ll)gap(rng);
+        ll b = 1000 + (ll)burst(rng);
+        if (i % 3 == 0)
+            tasks[i] = {t, b, 500 + (ll)(rng() % 1500), 2000 + (ll)(rng() % 8000), (int)(rng() % 11) - 5}; // interactive
+        else
+            tasks[i] = {t, b, b, 0, (int)(rng() % 11) - 5}; // batch
+    }
+    return tasks;
+}
+
+void print_row(const char *name, const Stats &st)
+{
+    cout << left << setw(14) << name << right << fixed << setprecision(1)
+         << setw(10) << st.switches << setw(12) << st.avg_wait / 1000 << setw(12) << st.avg_tat / 1000
+         << setw(12) << st.avg_response / 1000 << setw(11) << st.wake_p50 / 1000 << setw(11) << st.wake_p99 / 1000
+         << setw(12) << st.decision_ns << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 2000;
+    ll qt = argc > 2 ? atoll(argv[2]) : 4000;
+    unsigned seed = argc > 3 ? atoi(argv[3]) : 1;
+
+    // 1) Fairness: 8 CPU-bound tasks, nice -4 .. 10, all start at 0; look at 1 s of CPU time
+    vector<Task> hogs;
+    int nices[] = {-4, -2, 0, 0, 2, 4, 7, 10};
+    for (int nice : nices)
+        hogs.push_back({0, 10000000, 10000000, 0, nice});
+    ll window = 1000000;
+
+    RoundRobin rr(qt);
+    Cfs cfs(hogs);
+    Stats a = simulate(hogs, rr, window), b = simulate(hogs, cfs, window);
+
+    ll wsum = 0;
+    for (auto &h : hogs) wsum += prio_to_weight[h.nice + 20];
+    cout << "Fairness: 8 CPU-bound tasks for " << window / 1000 << " ms (share of CPU in %)\n";
+    cout << "Nice   Weight   Target    RR        CFS\n";
+    double rr_err = 0, cfs_err = 0;
+    for (size_t i = 0; i < hogs.size(); i++)
+    {
+        ll w = prio_to_weight[hogs[i].nice + 20];
+        double target = 100.0 * w / wsum, r = 100.0 * a.cpu[i] / window, c = 100.0 * b.cpu[i] / window;
+        rr_err = max(rr_err, fabs(r - target));
+        cfs_err = max(cfs_err, fabs(c - target));
+        cout << setw(4) << hogs[i].nice << setw(9) << w << fixed << setprecision(2)
+             << setw(9) << target << setw(10) << r << setw(10) << c << endl;
+    }
+    cout << "Max deviation from weighted share: RR " << rr_err << " points, CFS " << cfs_err << " points\n";
+
+    // 2) Same mixed trace through both policies
+    vector<Task> trace = mixed_trace(n, seed);
+    RoundRobin rr2(qt);
+    Cfs cfs2(trace);
+    Stats r = simulate(trace, rr2, INF);
+    Stats c = simulate(trace, cfs2, INF);
+
+    cout << "\nMixed trace: " << n << " tasks (1/3 interactive), RR quantum " << qt / 1000.0 << " ms, times in ms\n";
+    cout << left << setw(14) << "Policy" << right << setw(10) << "switches" << setw(12) << "avg wait"
+         << setw(12) << "avg TAT" << setw(12) << "avg resp" << setw(11) << "wake p50" << setw(11) << "wake p99"
+         << setw(12) << "ns/decision" << endl;
+    print_row("Round Robin", r);
+    print_row("CFS", c);
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 CFS.cpp -o /tmp/CFS
+Run:     /tmp/CFS [tasks] [RR quantum us] [seed]
+
+vruntime += ran * 1024 / weight
+    nice 0  -> vruntime grows as fast as real time
+    nice -5 -> weight 3121, vruntime grows 3x slower -> the task is picked ~3x as often
+slice  = max(6 ms, nr_running * 0.75 ms) * weight / total weight
+wakeup = vruntime = max(own vruntime, min_vruntime - 3 ms): a sleeper lands a little left
+         of everybody else, runs soon, but cannot take over the CPU for long.
+
+"wake p99" = 99th percentile of the time from wakeup/arrival until the task runs again.
+Interactive tasks under CFS have small vruntime after sleeping, so they run almost at once.
+*/
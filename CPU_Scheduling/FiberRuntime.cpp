@@ -0,0 +1,633 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <ctime>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if !defined(__x86_64__)
+#include <ucontext.h>
+#endif
+
+using namespace std;
+
+// M:N green threads: many fibers run on a few worker threads, and the ready queue is
+// ordered by the same policies the other programs in this folder only calculate:
+//   fcfs      run to completion in arrival order             (FCFS.cpp)
+//   rr        preempt after qt, back to the end of the queue  (RoundRobin.cpp)
+//   priority  lowest number first, run to completion          (PrioritySche.cpp)
+// Fibers really run (they spin for their burst time), so waiting and turnaround times are
+// measured with a clock and printed next to the numbers the paper algorithm predicts.
+//
+// Context switch: on x86-64 a few lines of assembly save the 6 callee-saved registers and
+// swap stack pointers (no syscall). Elsewhere ucontext is used (slower: it saves the signal mask).
+// Preemption: fibers call yield_point() in their loops. It switches out when the slice is
+// over - either by reading the clock, or by a flag set from a per-worker timer signal.
+// Bursts and slices are CPU time of the worker thread, not wall time. Reading that clock
+// is a syscall, so it is read only for fibers with a burst and in yield_point(); a plain
+// yield/dispatch makes none.
+
+typedef chrono::steady_clock Clock;
+
+inline long long now_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// CPU time of the calling worker thread: bursts and slices are counted with this, so a
+// worker that is descheduled (more workers than cores) does not use up its fiber's burst
+inline long long thread_cpu_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// ---------------- Context switching ----------------
+
+#if defined(__x86_64__)
+
+extern "C" void fiber_switch(void **save_sp, void *new_sp);
+asm(R"(
+    .text
+    .globl fiber_switch
+    .type fiber_switch, @function
+fiber_switch:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size fiber_switch, .-fiber_switch
+)");
+
+struct Context
+{
+    void *sp = nullptr;
+};
+
+inline void switch_context(Context &from, Context &to)
+{
+    fiber_switch(&from.sp, to.sp);
+}
+
+// Build a stack that fiber_switch can "return" into: 6 zero registers, then entry()
+void make_context(Context &c, char *stack, size_t size, void (*entry)())
+{
+    uintptr_t top = ((uintptr_t)(stack + size)) & ~(uintptr_t)15;
+    void **sp = (void **)top;
+    *--sp = nullptr;          // fake return address of entry(), keeps the ABI alignment
+    *--sp = (void *)entry;
+    for (int i = 0; i < 6; i++)
+        *--sp = nullptr;      // rbp rbx r12 r13 r14 r15
+    c.sp = sp;
+}
+
+#else
+
+struct Context
+{
+    ucontext_t uc;
+};
+
+inline void switch_context(Context &from, Context &to)
+{
+    swapcontext(&from.uc, &to.uc);
+}
+
+void make_context(Context &c, char *stack, size_t size, void (*entry)())
+{
+    getcontext(&c.uc);
+    c.uc.uc_stack.ss_sp = stack;
+    c.uc.uc_stack.ss_size = size;
+    c.uc.uc_link = nullptr;
+    makecontext(&c.uc, entry, 0);
+}
+
+#endif
+
+// ---------------- Stack pool ----------------
+
+// Stacks are mmap'ed once with a guard page below them and reused by later fibers.
+// All of them are unmapped when the pool goes away.
+
+const size_t STACK_SIZE = 64 * 1024;
+const size_t PAGE = 4096;
+
+struct StackPool
+{
+    mutex mtx;
+    vector<char *> free_stacks;
+    vector<char *> all;
+    atomic<int> mapped {0};
+
+    ~StackPool()
+    {
+        for (char *s : all) munmap(s - PAGE, STACK_SIZE + PAGE);
+    }
+
+    char *get()
+    {
+        {
+            lock_guard<mutex> lock(mtx);
+            if (!free_stacks.empty())
+            {
+                char *s = free_stacks.back();
+                free_stacks.pop_back();
+                return s;
+            }
+        }
+        char *m = (char *)mmap(NULL, STACK_SIZE + PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+        if (m == MAP_FAILED)
+        {
+            cerr << "mmap failed!" << endl;
+            exit(1);
+        }
+        mprotect(m, PAGE, PROT_NONE); // stack overflow -> SIGSEGV instead of silent corruption
+        mapped++;
+        lock_guard<mutex> lock(mtx);
+        all.push_back(m + PAGE);
+        return m + PAGE;
+    }
+
+    void put(char *s)
+    {
+        lock_guard<mutex> lock(mtx);
+        free_stacks.push_back(s);
+    }
+};
+
+// ---------------- Fibers ----------------
+
+struct Fiber
+{
+    int id;
+    int priority = 0;
+    long long burst_ns = 0;
+    void (*fn)(Fiber *) = nullptr;
+
+    Context ctx;
+    char *stack = nullptr;
+    bool done = false;
+
+    long long created = 0, first_run = -1, finished = 0;
+    long long ready_since = 0, waited = 0;
+    long long cpu_ns = 0, slice_start = 0; // thread CPU time (thread_cpu_ns)
+    long long switches = 0;
+};
+
+// ---------------- Policies ----------------
+
+struct Policy
+{
+    virtual ~Policy() {}
+    virtual void push(Fiber *f) = 0;
+    virtual Fiber *pop() = 0;             // nullptr if empty
+    virtual bool preemptive() { return false; }
+};
+
+struct FcfsPolicy : Policy
+{
+    deque<Fiber *> q;
+    void push(Fiber *f) override { q.push_back(f); }
+    Fiber *pop() override
+    {
+        if (q.empty()) return nullptr;
+        Fiber *f = q.front();
+        q.pop_front();
+        return f;
+    }
+};
+
+struct RoundRobinPolicy : FcfsPolicy
+{
+    bool preemptive() override { return true; }
+};
+
+struct PriorityPolicy : Policy
+{
+    struct Cmp
+    {
+        bool operator()(Fiber *a, Fiber *b) const
+        {
+            return a->priority != b->priority ? a->priority > b->priority : a->id > b->id;
+        }
+    };
+    priority_queue<Fiber *, vector<Fiber *>, Cmp> q;
+    void push(Fiber *f) override { q.push(f); }
+    Fiber *pop() override
+    {
+        if (q.empty()) return nullptr;
+        Fiber *f = q.top();
+        q.pop();
+        return f;
+    }
+};
+
+// ---------------- Runtime ----------------
+
+struct Worker
+{
+    Context sched_ctx;       // the worker thread's own stack
+    Fiber *current = nullptr;
+    long long slice_end = 0; // thread CPU time, 0 = not started yet (see yield_point)
+    volatile sig_atomic_t need_resched = 0;
+};
+
+thread_local Worker *tls_worker = nullptr;
+
+struct Runtime
+{
+    unique_ptr<Policy> policy;
+    long long qt_ns;
+    bool timer_mode;
+    StackPool stacks;
+
+    mutex mtx;
+    condition_variable cv;
+    int live = 0;            // fibers not finished yet
+    long long switches = 0;
+
+    Runtime(Policy *policy, long long qt_ns, bool timer_mode) : policy(policy), qt_ns(qt_ns), timer_mode(timer_mode) {}
+
+    void add(Fiber *f)
+    {
+        f->created = f->ready_since = now_ns();
+        lock_guard<mutex> lock(mtx);
+        live++;
+        policy->push(f);
+        cv.notify_one();
+    }
+
+    static void fiber_entry()
+    {
+        Worker *w = tls_worker;
+        Fiber *f = w->current;
+        f->fn(f);
+        f->done = true;
+        switch_context(f->ctx, tls_worker->sched_ctx); // never comes back
+    }
+
+    void worker_loop(Worker &w)
+    {
+        tls_worker = &w;
+        timer_t timer;
+        bool use_timer = timer_mode && policy->preemptive();
+        if (use_timer) create_timer(timer);
+
+        while (true)
+        {
+            Fiber *f;
+            {
+                unique_lock<mutex> lock(mtx);
+                while ((f = policy->pop()) == nullptr && live > 0)
+                    cv.wait(lock);
+                if (!f) break;
+                switches++;
+            }
+
+            if (!f->stack) // the stack is taken when the fiber first runs, so queued fibers cost no memory
+            {
+                f->stack = stacks.get();
+                make_context(f->ctx, f->stack, STACK_SIZE, fiber_entry);
+            }
+
+            long long t = now_ns();
+            if (f->first_run < 0) f->first_run = t;
+            f->waited += t - f->ready_since;
+            // Only fibers with a burst read the thread CPU clock here: it is a syscall, not vDSO
+            bool timed = f->burst_ns > 0;
+            if (timed) f->slice_start = thread_cpu_ns();
+            f->switches++;
+            w.current = f;
+            w.slice_end = timed ? f->slice_start + qt_ns : 0;
+            w.need_resched = 0;
+            if (use_timer) arm_timer(timer); // one-shot: fires qt after THIS slice started
+
+            switch_context(w.sched_ctx, f->ctx); // run until it yields or finishes
+
+            if (timed) f->cpu_ns += thread_cpu_ns() - f->slice_start;
+            t = now_ns();
+            w.current = nullptr;
+            if (f->done)
+            {
+                f->finished = t;
+                stacks.put(f->stack);
+                lock_guard<mutex> lock(mtx);
+                if (--live == 0) cv.notify_all();
+            }
+            else
+            {
+                f->ready_since = t;
+                lock_guard<mutex> lock(mtx);
+                policy->push(f);
+                cv.notify_one();
+            }
+        }
+
+        if (use_timer) timer_delete(timer);
+    }
+
+    // Per-thread POSIX timer on this thread's CPU clock: SIGALRM goes to THIS worker only
+    void create_timer(timer_t &timer)
+    {
+        sigevent sev;
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_THREAD_ID;
+        sev.sigev_signo = SIGALRM;
+        sev._sigev_un._tid = syscall(SYS_gettid);
+        if (timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &timer) != 0)
+        {
+            cerr << "timer_create failed!" << endl;
+            exit(1);
+        }
+    }
+
+    void arm_timer(timer_t timer)
+    {
+        itimerspec its;
+        memset(&its, 0, sizeof(its));
+        its.it_value.tv_sec = qt_ns / 1000000000LL;
+        its.it_value.tv_nsec = qt_ns % 1000000000LL;
+        timer_settime(timer, 0, &its, NULL);
+    }
+
+    void run(int num_workers)
+    {
+        vector<Worker> workers(num_workers);
+        vector<thread> threads;
+        for (int i = 0; i < num_workers; i++)
+            threads.emplace_back(&Runtime::worker_loop, this, ref(workers[i]));
+        for (auto &th : threads) th.join();
+    }
+};
+
+Runtime *runtime = nullptr;
+
+void on_tick(int)
+{
+    if (tls_worker) tls_worker->need_resched = 1;
+}
+
+// Give the CPU back to the worker (and the next fiber)
+inline void fiber_yield()
+{
+    Worker *w = tls_worker;
+    switch_context(w->current->ctx, w->sched_ctx);
+}
+
+// Called from the fibers' loops: cheap when there is nothing to do
+inline void yield_point()
+{
+    if (!runtime->policy->preemptive()) return;
+    Worker *w = tls_worker;
+    if (runtime->timer_mode)
+    {
+        if (w->need_resched) fiber_yield();
+        return;
+    }
+    long long now = thread_cpu_ns();
+    if (w->slice_end == 0) w->slice_end = now + runtime->qt_ns; // no burst: the slice starts at the first check
+    else if (now >= w->slice_end) fiber_yield();
+}
+
+// CPU time this fiber got so far, including the running slice
+inline long long fiber_cpu_ns(Fiber *f)
+{
+    return f->cpu_ns + (thread_cpu_ns() - f->slice_start);
+}
+
+// ---------------- Workloads ----------------
+
+volatile unsigned long long sink;
+
+// A "process" with a CPU burst: spin until burst_ns of CPU time, with yield points
+void cpu_task(Fiber *f)
+{
+    unsigned long long x = f->id;
+    while (true)
+    {
+        for (int i = 0; i < 2000; i++) // a clock read costs a syscall here, keep it rare
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        if (fiber_cpu_ns(f) >= f->burst_ns) break; // done: finishing beats being preempted
+        yield_point();
+    }
+    sink = x;
+}
+
+// Two fibers handing the CPU to each other
+long long ping_pong_rounds = 0;
+void ping_pong_task(Fiber *)
+{
+    for (long long i = 0; i < ping_pong_rounds; i++)
+        fiber_yield();
+}
+
+void empty_task(Fiber *) {}
+
+// ---------------- Paper numbers ----------------
+
+// Same formulas as FCFS.cpp / RoundRobin.cpp / PrioritySche.cpp (all arrive at 0, one CPU)
+void simulated_times(const string &policy, const vector<int> &bt, const vector<int> &prio, int qt, vector<int> &wt, vector<int> &tat)
+{
+    int n = bt.size();
+    wt.assign(n, 0);
+    tat.assign(n, 0);
+    if (policy == "rr")
+    {
+        vector<int> left = bt, last(n, 0);
+        int curr_time = 0, completed = 0;
+        while (completed < n)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (left[i] == 0) continue;
+                wt[i] += curr_time - last[i];
+                int run = min(left[i], qt);
+                curr_time += run;
+                left[i] -= run;
+                if (left[i] == 0) completed++;
+                last[i] = curr_time;
+            }
+        }
+    }
+    else
+    {
+        vector<int> order(n);
+        for (int i = 0; i < n; i++) order[i] = i;
+        if (policy == "priority")
+            stable_sort(order.begin(), order.end(), [&](int a, int b) { return prio[a] < prio[b]; });
+        int t = 0;
+        for (int i : order)
+        {
+            wt[i] = t;
+            t += bt[i];
+        }
+    }
+    for (int i = 0; i < n; i++) tat[i] = wt[i] + bt[i];
+}
+
+Policy *make_policy(const string &name)
+{
+    if (name == "rr") return new RoundRobinPolicy();
+    if (name == "priority") return new PriorityPolicy();
+    return new FcfsPolicy();
+}
+
+int main(int argc, char *argv[])
+{
+    string policy = argc > 1 ? argv[1] : "rr";
+    int qt = argc > 2 ? atoi(argv[2]) : 2;
+    int num_workers = argc > 3 ? atoi(argv[3]) : 1;
+    bool timer_mode = argc > 4 && string(argv[4]) == "timer";
+    const long long UNIT = 10 * 1000000LL; // 1 time unit of the paper algorithms = 10 ms
+    if (num_workers < 1) num_workers = 1;
+    if (qt < 1) qt = 1;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_tick;
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGALRM, &sa, NULL);
+
+    // 1) Raw context switch cost: two fibers yielding to each other through one worker
+    {
+        Runtime rt(new RoundRobinPolicy(), 1000000000LL, false);
+        runtime = &rt;
+        ping_pong_rounds = 1000000;
+        vector<unique_ptr<Fiber>> fibers;
+        for (int i = 0; i < 2; i++)
+        {
+            fibers.emplace_back(new Fiber());
+            fibers[i]->id = i;
+            fibers[i]->fn = ping_pong_task;
+            rt.add(fibers[i].get());
+        }
+        auto t0 = Clock::now();
+        rt.run(1);
+        double ns = chrono::duration<double, nano>(Clock::now() - t0).count();
+        cout << "Yield round trip (fiber -> worker -> next fiber, incl. locked queue): "
+             << fixed << setprecision(1) << ns / (2 * ping_pong_rounds) << " ns" << endl;
+
+        // Bare switch without the run queue
+        Context a, b;
+        char *stack = rt.stacks.get();
+        static Context *pa, *pb;
+        pa = &a;
+        pb = &b;
+        make_context(b, stack, STACK_SIZE, [] {
+            while (true) switch_context(*pb, *pa);
+        });
+        const int N = 5000000;
+        t0 = Clock::now();
+        for (int i = 0; i < N; i++)
+            switch_context(a, b);
+        ns = chrono::duration<double, nano>(Clock::now() - t0).count();
+        cout << "Bare context switch: " << ns / (2.0 * N) << " ns" << endl;
+    }
+
+    // 2) Many short fibers: stack pool reuse
+    {
+        Runtime rt(new FcfsPolicy(), 1000000000LL, false);
+        runtime = &rt;
+        const int N = 100000;
+        vector<unique_ptr<Fiber>> fibers;
+        auto t0 = Clock::now();
+        thread workers([&] { rt.run(num_workers); });
+        for (int i = 0; i < N; i++)
+        {
+            fibers.emplace_back(new Fiber());
+            fibers[i]->id = i;
+            fibers[i]->fn = empty_task;
+            rt.add(fibers[i].get());
+        }
+        workers.join();
+        double ms = chrono::duration<double, milli>(Clock::now() - t0).count();
+        cout << N << " empty fibers created and run in " << setprecision(1) << ms << " ms, stacks mapped: "
+             << rt.stacks.mapped << endl;
+    }
+
+    // 3) The scheduling policy on real work
+    vector<int> bt = {5, 3, 8, 6, 2}, prio = {3, 1, 4, 2, 5};
+    int n = bt.size();
+    Runtime rt(make_policy(policy), qt * UNIT, timer_mode);
+    runtime = &rt;
+    vector<unique_ptr<Fiber>> fibers;
+    for (int i = 0; i < n; i++)
+    {
+        fibers.emplace_back(new Fiber());
+        fibers[i]->id = i;
+        fibers[i]->priority = prio[i];
+        fibers[i]->burst_ns = bt[i] * UNIT;
+        fibers[i]->fn = cpu_task;
+    }
+    for (auto &f : fibers) rt.add(f.get()); // all "arrive" at time 0, in order
+    long long start = fibers[0]->created;
+    rt.run(num_workers);
+
+    vector<int> wt, tat;
+    simulated_times(policy, bt, prio, qt, wt, tat);
+
+    cout << "\nPolicy: " << policy << (policy == "rr" ? ", qt = " + to_string(qt) : string(""))
+         << ", " << num_workers << " worker(s), preemption: " << (timer_mode ? "timer signal" : "clock check")
+         << "   (1 unit = " << UNIT / 1000000 << " ms)\n";
+    cout << "Process\tBT\tPrio\tWT sim\tWT real\tTAT sim\tTAT real\tswitches\n";
+    double sum_wt = 0, sum_tat = 0;
+    for (int i = 0; i < n; i++)
+    {
+        Fiber &f = *fibers[i];
+        double wt_real = (double)f.waited / UNIT, tat_real = (double)(f.finished - start) / UNIT;
+        sum_wt += wt_real;
+        sum_tat += tat_real;
+        cout << "P" << i + 1 << "\t" << bt[i] << "\t" << prio[i] << "\t" << wt[i] << "\t" << setprecision(2) << wt_real
+             << "\t" << tat[i] << "\t" << tat_real << "\t\t" << f.switches << endl;
+    }
+    int sim_wt = 0, sim_tat = 0;
+    for (int i = 0; i < n; i++)
+    {
+        sim_wt += wt[i];
+        sim_tat += tat[i];
+    }
+    cout << "Average WT:  simulated " << (double)sim_wt / n << ", measured " << sum_wt / n << endl;
+    cout << "Average TAT: simulated " << (double)sim_tat / n << ", measured " << sum_tat / n << endl;
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -pthread FiberRuntime.cpp -o /tmp/FiberRuntime
+Run:     /tmp/FiberRuntime [fcfs|rr|priority] [qt] [workers] [clock|timer]
+Example: /tmp/FiberRuntime rr 2 1 timer
+
+With 1 worker the measured times match the paper algorithm (plus a few microseconds of
+switching). With more workers several fibers run at once, so waiting times drop.
+
+Fiber vs thread: a fiber switch is a function call that swaps stacks in user space.
+A thread switch goes through the kernel (futex / scheduler), about 1-5 microseconds.
+The assembly switch does not save the x87/SSE control words; the fibers here never change them.
+*/
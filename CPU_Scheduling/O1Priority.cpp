@@ -0,0 +1,392 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <climits>
+using namespace std;
+
+// Priority scheduling the way the Linux O(1) scheduler (2.6.0 - 2.6.22) did it, next to the
+// "scan for the best priority" approach of PrioritySche.cpp.
+//
+//   - 140 priorities, lower = more important (0-99 real-time, 100-139 = nice -20..19)
+//   - one FIFO queue per priority plus a 140-bit bitmap of non-empty queues;
+//     next job = first set bit (3 x count-trailing-zeros) -> O(1), no matter how many jobs wait
+//   - two arrays of queues: active and expired. A job that used up its timeslice goes to the
+//     expired array; when active is empty the two are swapped (one pointer swap, no requeueing)
+//
+// Aging (against starvation), also without looking at individual jobs: every `age` time units
+// each normal queue p in 101..139 is appended to queue p-1 (39 list splices per array). A job that
+// waits k intervals therefore runs at priority max(100, static - k). When it runs, it drops
+// back to its static priority. Because new high-priority work keeps landing in the active
+// array, the expired array is also swapped in once its oldest job has waited 40 intervals.
+// Times are in ms.
+
+typedef long long ll;
+const ll INF = LLONG_MAX;
+const int NPRIO = 140, MAX_RT_PRIO = 100;
+
+struct Job
+{
+    ll arrival;
+    ll burst;
+    int prio; // static priority 0..139
+};
+
+// Linux O(1) base timeslice: 800 ms for nice -20, 100 ms nice 0, 5 ms nice 19; 100 ms RT
+ll timeslice(int prio)
+{
+    if (prio < MAX_RT_PRIO) return 100;
+    return prio < 120 ? (NPRIO - prio) * 20 : max(5, (NPRIO - prio) * 5);
+}
+
+struct State
+{
+    ll left, slice_left;
+    ll ready_since = 0, waited = 0, max_wait = 0;
+    ll first_run = -1, finish = -1;
+};
+
+// ---------------- Scan policy (PrioritySche.cpp, but preemptive and with arrivals) ----------------
+
+struct Scan
+{
+    const vector<Job> &jobs;
+    vector<pair<ll, int>> ready; // (enqueue sequence, job)
+    ll seq = 0;
+
+    Scan(const vector<Job> &jobs) : jobs(jobs) {}
+
+    void add(int j) { ready.push_back({seq++, j}); }
+    void requeue(int j) { add(j); }
+    void expire(int j) { add(j); }
+    bool empty() { return ready.empty(); }
+
+    // O(n): look at every waiting job
+    int pick(ll)
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < ready.size(); i++)
+        {
+            const Job &a = jobs[ready[i].second], &b = jobs[ready[best].second];
+            if (a.prio < b.prio || (a.prio == b.prio && ready[i].first < ready[best].first))
+                best = i;
+        }
+        int j = ready[best].second;
+        ready[best] = ready.back();
+        ready.pop_back();
+        running_prio = jobs[j].prio;
+        return j;
+    }
+
+    int running_prio = NPRIO;
+    bool preempts(int j) { return jobs[j].prio < running_prio; }
+};
+
+// ---------------- O(1) bitmap policy ----------------
+
+// 140 FIFO queues as linked lists through next[] (shared by both arrays, a job is in one queue)
+struct PrioArray
+{
+    unsigned long long bitmap[3] = {0, 0, 0};
+    int head[NPRIO], tail[NPRIO];
+    int count = 0;
+
+    PrioArray() { fill(head, head + NPRIO, -1); }
+
+    void push(vector<int> &next, int p, int j)
+    {
+        next[j] = -1;
+        if (head[p] < 0) head[p] = j;
+        else next[tail[p]] = j;
+        tail[p] = j;
+        bitmap[p / 64] |= 1ULL << (p % 64);
+        count++;
+    }
+
+    int first_prio()
+    {
+        for (int w = 0; w < 3; w++)
+            if (bitmap[w]) return w * 64 + __builtin_ctzll(bitmap[w]);
+        return -1;
+    }
+
+    int pop(vector<int> &next, int p)
+    {
+        int j = head[p];
+        head[p] = next[j];
+        if (head[p] < 0) bitmap[p / 64] &= ~(1ULL << (p % 64));
+        count--;
+        return j;
+    }
+
+    // Append queue p to the end of queue 'to' (to < p): everybody in p moves up, O(1)
+    void promote(vector<int> &next, int p, int to)
+    {
+        if (head[p] < 0) return;
+        if (head[to] < 0) head[to] = head[p];
+        else next[tail[to]] = head[p];
+        tail[to] = tail[p];
+        head[p] = -1;
+        bitmap[to / 64] |= 1ULL << (to % 64);
+        bitmap[p / 64] &= ~(1ULL << (p % 64));
+    }
+};
+
+struct O1
+{
+    const vector<Job> &jobs;
+    vector<int> next;
+    PrioArray arrays[2];
+    PrioArray *active = &arrays[0], *expired = &arrays[1];
+    ll age;                 // aging interval, 0 = no aging
+    ll last_age = 0;
+    ll expired_since = -1;  // when the oldest job in the expired array got there
+    int running_prio = NPRIO;
+    ll swaps = 0, forced_swaps = 0;
+
+    O1(const vector<Job> &jobs, ll age) : jobs(jobs), next(jobs.size(), -1), age(age) {}
+
+    void add(int j) { active->push(next, jobs[j].prio, j); }
+    void requeue(int j) { active->push(next, jobs[j].prio, j); } // preempted, keeps its slice
+    void expire(int j, ll now)
+    {
+        if (jobs[j].prio < MAX_RT_PRIO)
+        {
+            active->push(next, jobs[j].prio, j); // real-time jobs never expire
+            return;
+        }
+        if (expired->count == 0) expired_since = now;
+        expired->push(next, jobs[j].prio, j);
+    }
+    bool empty() { return active->count + expired->count == 0; }
+
+    // k intervals passed: queue p moves to max(100, p - k). Going up from 101 every queue is
+    // moved away before anything lands in it, so one pass of 39 splices per array does all
+    // k steps - the cost never depends on how many jobs wait.
+    void do_aging(ll now)
+    {
+        if (age <= 0) return;
+        ll k = (now - last_age) / age;
+        if (k == 0) return;
+        last_age += k * age;
+        for (int p = MAX_RT_PRIO + 1; p < NPRIO; p++)
+        {
+            int to = max<ll>(MAX_RT_PRIO, p - k);
+            active->promote(next, p, to);
+            expired->promote(next, p, to);
+        }
+    }
+
+    int pick(ll now)
+    {
+        do_aging(now);
+        bool starving = age > 0 && expired->count > 0 && now - expired_since > 40 * age;
+        if (active->count == 0 || starving)
+        {
+            swap(active, expired);
+            swaps++;
+            if (starving && expired->count > 0) forced_swaps++;
+            expired_since = expired->count > 0 ? now : -1;
+        }
+        int p = active->first_prio();
+        running_prio = p;
+        return active->pop(next, p);
+    }
+
+    bool preempts(int j) { return jobs[j].prio < running_prio; }
+};
+
+// The Scan policy has no expired array
+void expire_job(Scan &s, int j, ll) { s.expire(j); }
+void expire_job(O1 &s, int j, ll now) { s.expire(j, now); }
+
+// ---------------- Event-driven simulation ----------------
+
+struct Stats
+{
+    ll decisions = 0;
+    double decision_ns = 0;
+    vector<State> s;
+};
+
+// Jobs must be sorted by arrival. Stops when all finished, at 'horizon' or after 'max_decisions'.
+template <class Policy>
+Stats simulate(const vector<Job> &jobs, Policy &policy, ll horizon, ll max_decisions = INF)
+{
+    int n = jobs.size(), arrived = 0, done = 0, curr = -1;
+    Stats st;
+    st.s.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        st.s[i].left = jobs[i].burst;
+        st.s[i].slice_left = timeslice(jobs[i].prio);
+    }
+    vector<State> &s = st.s;
+    ll now = 0;
+    auto t0 = chrono::steady_clock::now();
+
+    auto make_ready = [&](int j) { s[j].ready_since = now; };
+
+    while (done < n && now < horizon && st.decisions < max_decisions)
+    {
+        if (curr < 0)
+        {
+            if (policy.empty()) now = max(now, jobs[arrived].arrival);
+            for (; arrived < n && jobs[arrived].arrival <= now; arrived++)
+            {
+                make_ready(arrived);
+                policy.add(arrived);
+            }
+            curr = policy.pick(now);
+            if (++st.decisions == 1)
+                t0 = chrono::steady_clock::now(); // the first decision also admits the initial batch
+
+            ll w = now - s[curr].ready_since;
+            s[curr].waited += w;
+            s[curr].max_wait = max(s[curr].max_wait, w);
+            if (s[curr].first_run < 0) s[curr].first_run = now;
+        }
+
+        ll next_arrival = arrived < n ? jobs[arrived].arrival : INF;
+        ll end = min({now + s[curr].left, now + s[curr].slice_left, next_arrival, horizon});
+        s[curr].left -= end - now;
+        s[curr].slice_left -= end - now;
+        now = end;
+
+        if (s[curr].left == 0)
+        {
+            s[curr].finish = now;
+            done++;
+            curr = -1;
+        }
+        else if (s[curr].slice_left == 0)
+        {
+            s[curr].slice_left = timeslice(jobs[curr].prio);
+            make_ready(curr);
+            expire_job(policy, curr, now);
+            curr = -1;
+        }
+
+        for (; arrived < n && jobs[arrived].arrival <= now; arrived++)
+        {
+            make_ready(arrived);
+            policy.add(arrived);
+            if (curr >= 0 && policy.preempts(arrived))
+            {
+                make_ready(curr);
+                policy.requeue(curr);
+                curr = -1;
+            }
+        }
+    }
+    st.decision_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / max(1LL, st.decisions - 1);
+    return st;
+}
+
+// ---------------- Workloads ----------------
+
+// Busy server: a steady stream of short important jobs (prio 100-109) uses ~88% of the CPU,
+// longer background jobs (prio 130-139) need another ~8%.
+vector<Job> starvation_trace(int n, unsigned seed)
+{
+    mt19937 rng(seed);
+    exponential_distribution<double> gap(1.0 / 21.5);
+    vector<Job> jobs;
+    ll t = 0;
+    for (int i = 0; i < n; i++)
+    {
+        t += (ll)gap(rng) + 1;
+        if (i % 10 == 9)
+            jobs.push_back({t, 10 + (ll)(rng() % 30), 130 + (int)(rng() % 10)});
+        else
+            jobs.push_back({t, 10 + (ll)(rng() % 21), 100 + (int)(rng() % 10)});
+    }
+    return jobs;
+}
+
+// Waiting time per priority class
+void report(const char *name, const vector<Job> &jobs, const Stats &st, ll horizon)
+{
+    const int CLASSES = 2;
+    const char *label[CLASSES] = {"prio 100-109", "prio 130-139"};
+    ll cnt[CLASSES] = {}, fin[CLASSES] = {}, max_wait[CLASSES] = {};
+    double wait[CLASSES] = {};
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        int c = jobs[i].prio >= 120;
+        cnt[c]++;
+        // Unfinished jobs count with what they have waited so far (starvation shows up here)
+        ll w = st.s[i].waited;
+        if (st.s[i].finish < 0 && jobs[i].arrival < horizon)
+            w += horizon - max(jobs[i].arrival, st.s[i].ready_since);
+        max_wait[c] = max(max_wait[c], max(w, st.s[i].max_wait));
+        wait[c] += w;
+        fin[c] += st.s[i].finish >= 0;
+    }
+    for (int c = 0; c < CLASSES; c++)
+        cout << left << setw(20) << (c == 0 ? name : "") << setw(14) << label[c] << right << setw(8) << cnt[c]
+             << setw(10) << fin[c] << fixed << setprecision(1) << setw(12) << wait[c] / max(1LL, cnt[c])
+             << setw(12) << max_wait[c] << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    ll age = argc > 2 ? atoll(argv[2]) : 20;
+    unsigned seed = argc > 3 ? atoi(argv[3]) : 1;
+
+    // 1) Dispatch cost vs number of waiting jobs: everybody is ready at t = 0
+    cout << "Dispatch cost (ns per decision, 20000 decisions)\n";
+    cout << "Waiting jobs      Scan        O(1)\n";
+    for (int size = 100; size <= 1000000; size *= 10)
+    {
+        mt19937 rng(seed);
+        vector<Job> ready(size);
+        for (auto &j : ready) j = {0, 1000000, 100 + (int)(rng() % 40)};
+        Scan scan(ready);
+        O1 o1(ready, age);
+        Stats a = size <= 100000 ? simulate(ready, scan, INF, 20000) : Stats();
+        Stats b = simulate(ready, o1, INF, 20000);
+        cout << setw(12) << size << fixed << setprecision(1);
+        if (size <= 100000) cout << setw(10) << a.decision_ns;
+        else cout << setw(10) << "-";
+        cout << setw(12) << b.decision_ns << endl;
+    }
+
+    // 2) Starvation: same trace through all three
+    vector<Job> jobs = starvation_trace(n, seed);
+    ll horizon = jobs.back().arrival;
+    Scan scan(jobs);
+    O1 plain(jobs, 0), aged(jobs, age);
+    Stats a = simulate(jobs, scan, horizon);
+    Stats b = simulate(jobs, plain, horizon);
+    Stats c = simulate(jobs, aged, horizon);
+
+    cout << "\n" << n << " jobs over " << horizon / 1000 << " s, aging interval " << age << " ms (times in ms)\n";
+    cout << left << setw(20) << "Policy" << setw(14) << "Class" << right << setw(8) << "jobs" << setw(10)
+         << "finished" << setw(12) << "avg wait" << setw(12) << "max wait" << endl;
+    report("Scan (no aging)", jobs, a, horizon);
+    report("O(1) no aging", jobs, b, horizon);
+    report("O(1) + aging", jobs, c, horizon);
+    cout << "O(1) + aging: " << aged.swaps << " array swaps, " << aged.forced_swaps << " forced by a starving expired array\n";
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 O1Priority.cpp -o /tmp/O1Priority
+Run:     /tmp/O1Priority [jobs] [aging interval ms] [seed]
+
+Dispatch cost: Scan grows with the number of waiting jobs (it looks at all of them), O(1)
+stays flat: find the first set bit in 3 words, pop the head of that queue.
+
+Starvation: the important jobs always have the better priority, so without aging the
+background jobs only run in the gaps the important ones leave, and in a busy stretch they
+wait for tens of seconds. With aging a background job climbs one level per interval and is
+at prio 100 after at most 39 intervals; from there it only waits for the jobs that got to
+queue 100 before it. The important jobs pay for that with a somewhat higher average wait.
+The O(1) dispatch numbers include the simulation loop around pick(), not just the pick.
+*/
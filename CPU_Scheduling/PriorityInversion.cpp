@@ -0,0 +1,332 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <climits>
+using namespace std;
+
+// Priority inversion: preemptive priority scheduling (as in PrioritySche.cpp, lower number =
+// higher priority) where jobs lock shared resources during their bursts.
+//
+// A high-priority job H that needs a resource held by a low-priority job L has to wait for L.
+// That much is unavoidable. The problem is everything in between: a medium-priority job M
+// preempts L, so H waits for M too - for as long as M runs (Mars Pathfinder, 1997).
+//
+//   none     L keeps its own priority while it holds the lock
+//   inherit  priority inheritance: a lock holder runs at the best priority of the jobs
+//            waiting for its locks (transitively). H waits at most for the critical sections
+//            of lower jobs, never for M.
+//   ceiling  immediate priority ceiling (highest locker): taking a lock raises the holder to
+//            the ceiling = best priority of any task that uses the lock. A job can then only
+//            be blocked once, before it starts, for at most one critical section, and
+//            deadlock is impossible.
+//
+// "Blocking" of a job = time it is ready but a job with a WORSE base priority runs.
+// Time is in ticks; the simulation advances one tick at a time.
+
+enum Protocol { NONE, INHERIT, CEILING };
+const char *protocol_name[] = {"none", "inherit", "ceiling"};
+
+struct Section
+{
+    int start, len, res; // lock res after 'start' ticks of execution, hold it for 'len' ticks
+};
+
+struct Task
+{
+    string name;
+    int prio;
+    int offset, period, wcet; // period 0 = runs once
+    vector<Section> sections;
+};
+
+struct Job
+{
+    int task, release, done = 0;
+    int waiting_on = -1; // resource it is blocked on
+    int blocked = 0;     // ticks of priority-inversion blocking
+    vector<int> holds;
+};
+
+struct TaskStats
+{
+    int jobs = 0, misses = 0;
+    vector<int> blocking, response;
+};
+
+struct Result
+{
+    vector<TaskStats> tasks;
+    string timeline; // one character per tick: name of the running task, '.' = idle
+    bool deadlock = false;
+};
+
+Result simulate(const vector<Task> &tasks, int nres, Protocol proto, int horizon, bool keep_timeline)
+{
+    int n = tasks.size();
+    // Ceiling of a resource = best priority of the tasks that use it
+    vector<int> ceiling(nres, INT_MAX);
+    for (auto &t : tasks)
+        for (auto &s : t.sections)
+            ceiling[s.res] = min(ceiling[s.res], t.prio);
+
+    Result r;
+    r.tasks.resize(n);
+    vector<Job> jobs; // active jobs, oldest first
+    vector<int> owner(nres, -1); // index into jobs
+
+    for (int now = 0; now < horizon; now++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            const Task &t = tasks[i];
+            if (now >= t.offset && (t.period ? (now - t.offset) % t.period == 0 : now == t.offset))
+            {
+                Job j;
+                j.task = i;
+                j.release = now;
+                jobs.push_back(j);
+            }
+        }
+
+        // Effective priorities
+        int m = jobs.size();
+        vector<int> eff(m);
+        for (int j = 0; j < m; j++)
+        {
+            eff[j] = tasks[jobs[j].task].prio;
+            if (proto == CEILING)
+                for (int res : jobs[j].holds)
+                    eff[j] = min(eff[j], ceiling[res]);
+        }
+        if (proto == INHERIT) // pass priorities along waiter -> owner edges until nothing changes
+        {
+            for (bool changed = true; changed;)
+            {
+                changed = false;
+                for (int j = 0; j < m; j++)
+                {
+                    if (jobs[j].waiting_on < 0) continue;
+                    int o = owner[jobs[j].waiting_on];
+                    if (eff[j] < eff[o])
+                    {
+                        eff[o] = eff[j];
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        // Pick the best job that can run; a job about to lock a busy resource blocks instead
+        int run = -1;
+        for (;;)
+        {
+            run = -1;
+            for (int j = 0; j < m; j++)
+                if (jobs[j].waiting_on < 0 && (run < 0 || eff[j] < eff[run]))
+                    run = j;
+            if (run < 0) break;
+
+            Job &job = jobs[run];
+            int want = -1;
+            for (auto &s : tasks[job.task].sections)
+                if (s.start == job.done && find(job.holds.begin(), job.holds.end(), s.res) == job.holds.end())
+                    want = s.res;
+            if (want < 0) break;
+            if (owner[want] < 0)
+            {
+                owner[want] = run;
+                job.holds.push_back(want);
+                if (proto == CEILING) eff[run] = min(eff[run], ceiling[want]);
+                continue; // may lock a second (nested) resource at the same tick
+            }
+            job.waiting_on = want;
+            if (proto == INHERIT) // the owner (and whoever it waits for) inherits right away
+                for (int o = owner[want]; o >= 0 && eff[o] > eff[run]; o = jobs[o].waiting_on < 0 ? -1 : owner[jobs[o].waiting_on])
+                    eff[o] = eff[run];
+        }
+
+        if (run < 0)
+        {
+            bool blocked = false;
+            for (auto &j : jobs) blocked |= j.waiting_on >= 0;
+            if (blocked)
+            {
+                r.deadlock = true;
+                return r;
+            }
+            if (keep_timeline) r.timeline += '.';
+            continue;
+        }
+
+        // Everybody waiting while a lower-priority job runs is being blocked
+        int run_prio = tasks[jobs[run].task].prio;
+        for (int j = 0; j < m; j++)
+            if (j != run && tasks[jobs[j].task].prio < run_prio)
+                jobs[j].blocked++;
+        if (keep_timeline) r.timeline += tasks[jobs[run].task].name[0];
+
+        Job &job = jobs[run];
+        job.done++;
+        for (auto &s : tasks[job.task].sections)
+        {
+            if (s.start + s.len != job.done) continue;
+            owner[s.res] = -1;
+            job.holds.erase(find(job.holds.begin(), job.holds.end(), s.res));
+            for (auto &w : jobs)
+                if (w.waiting_on == s.res) w.waiting_on = -1; // they try again when picked
+        }
+
+        if (job.done == tasks[job.task].wcet)
+        {
+            TaskStats &ts = r.tasks[job.task];
+            int response = now + 1 - job.release;
+            ts.jobs++;
+            ts.blocking.push_back(job.blocked);
+            ts.response.push_back(response);
+            if (tasks[job.task].period && response > tasks[job.task].period) ts.misses++;
+            // Owners are job indices: shift the ones behind the finished job
+            for (auto &o : owner)
+                if (o > run) o--;
+            jobs.erase(jobs.begin() + run);
+        }
+    }
+    return r;
+}
+
+int pct(vector<int> v, double p)
+{
+    if (v.empty()) return 0;
+    sort(v.begin(), v.end());
+    return v[min(v.size() - 1, (size_t)(p / 100 * v.size()))];
+}
+
+// ---------------- 1) The textbook case ----------------
+
+void pathfinder()
+{
+    // L locks the bus, H needs the bus shortly after, M is long and needs nothing
+    vector<Task> tasks = {
+        {"H", 1, 3, 0, 4, {{1, 2, 0}}},
+        {"M", 2, 5, 0, 12, {}},
+        {"L", 3, 0, 0, 8, {{1, 5, 0}}},
+    };
+    cout << "Three jobs, one resource (H: prio 1, arrives at 3; M: prio 2, arrives at 5; L: prio 3, locks at 1 for 5 ticks)\n";
+    cout << "Protocol  Timeline                      H blocked  H response\n";
+    for (Protocol p : {NONE, INHERIT, CEILING})
+    {
+        Result r = simulate(tasks, 1, p, 30, true);
+        while (!r.timeline.empty() && r.timeline.back() == '.') r.timeline.pop_back();
+        cout << left << setw(10) << protocol_name[p] << setw(30) << r.timeline << right
+             << setw(9) << r.tasks[0].blocking[0] << setw(12) << r.tasks[0].response[0] << endl;
+    }
+}
+
+// ---------------- 2) Random periodic task sets ----------------
+
+vector<Task> random_tasks(int n, int nres, mt19937 &rng)
+{
+    vector<Task> tasks;
+    int periods[] = {50, 80, 100, 200, 250, 400, 500, 1000};
+    for (int i = 0; i < n; i++)
+    {
+        Task t;
+        t.name = string(1, 'A' + i);
+        t.prio = i + 1; // rate monotonic-ish: sorted periods below
+        t.period = periods[min<int>(7, i * 8 / n + rng() % 2)];
+        t.offset = rng() % 20;
+        t.wcet = max(2, (int)(t.period * 0.6 / n));
+        int k = rng() % 3; // 0-2 non-nested critical sections
+        int pos = 0;
+        for (int s = 0; s < k && pos < t.wcet - 1; s++)
+        {
+            int start = pos + rng() % max(1, (t.wcet - pos) / 2);
+            int len = 1 + rng() % max(1, min(t.wcet - start, t.wcet / 2));
+            if (start + len > t.wcet) break;
+            t.sections.push_back({start, len, (int)(rng() % nres)});
+            pos = start + len;
+        }
+        tasks.push_back(t);
+    }
+    sort(tasks.begin(), tasks.end(), [](const Task &a, const Task &b) { return a.period < b.period; });
+    for (int i = 0; i < n; i++) tasks[i].prio = i + 1;
+    return tasks;
+}
+
+// Ceiling protocol bound for task i: the longest critical section of a lower-priority task
+// on a resource whose ceiling is at least as good as task i's priority
+int ceiling_bound(const vector<Task> &tasks, int nres, int i)
+{
+    vector<int> ceiling(nres, INT_MAX);
+    for (auto &t : tasks)
+        for (auto &s : t.sections) ceiling[s.res] = min(ceiling[s.res], t.prio);
+    int b = 0;
+    for (auto &t : tasks)
+        if (t.prio > tasks[i].prio)
+            for (auto &s : t.sections)
+                if (ceiling[s.res] <= tasks[i].prio) b = max(b, s.len);
+    return b;
+}
+
+int main(int argc, char *argv[])
+{
+    int sets = argc > 1 ? atoi(argv[1]) : 200;
+    int n = argc > 2 ? atoi(argv[2]) : 6;
+    int nres = argc > 3 ? atoi(argv[3]) : 2;
+    unsigned seed = argc > 4 ? atoi(argv[4]) : 1;
+
+    pathfinder();
+
+    // Blocking of the top-priority task over many random task sets
+    const int HORIZON = 20000;
+    mt19937 rng(seed);
+    vector<int> block[3], resp[3];
+    int misses[3] = {}, deadlocks[3] = {}, bound_violations = 0;
+    for (int k = 0; k < sets; k++)
+    {
+        vector<Task> tasks = random_tasks(n, nres, rng);
+        for (Protocol p : {NONE, INHERIT, CEILING})
+        {
+            Result r = simulate(tasks, nres, p, HORIZON, false);
+            if (r.deadlock)
+            {
+                deadlocks[p]++;
+                continue;
+            }
+            TaskStats &top = r.tasks[0];
+            block[p].insert(block[p].end(), top.blocking.begin(), top.blocking.end());
+            resp[p].insert(resp[p].end(), top.response.begin(), top.response.end());
+            for (auto &ts : r.tasks) misses[p] += ts.misses;
+            if (p == CEILING)
+                for (int b : top.blocking)
+                    bound_violations += b > ceiling_bound(tasks, nres, 0);
+        }
+    }
+
+    cout << "\n" << sets << " random task sets, " << n << " periodic tasks, " << nres << " resources, "
+         << HORIZON << " ticks each\n";
+    cout << "Top-priority task:   blocking p50   p99   max   response p99   max   | deadline misses (all tasks)\n";
+    for (Protocol p : {NONE, INHERIT, CEILING})
+        cout << left << setw(10) << protocol_name[p] << right << setw(20) << pct(block[p], 50) << setw(6)
+             << pct(block[p], 99) << setw(6) << pct(block[p], 100) << setw(15) << pct(resp[p], 99) << setw(6)
+             << pct(resp[p], 100) << "   | " << misses[p] << endl;
+    cout << "Ceiling protocol: blocking above the one-critical-section bound: " << bound_violations << " jobs\n";
+    return 0;
+}
+
+/*
+Compile: g++ -O2 PriorityInversion.cpp -o /tmp/PriorityInversion
+Run:     /tmp/PriorityInversion [task sets] [tasks] [resources] [seed]
+
+Timeline letters = which job runs in that tick. With "none" the M run sits between H's
+arrival and H getting the lock: H's blocking grows with M's length (unbounded if M were
+longer). With "inherit" L runs at H's priority until it unlocks, with "ceiling" L runs at
+the ceiling from the moment it locks, so M cannot preempt it in either case.
+
+For random sets the worst-case blocking of the top task is what matters for a real-time
+guarantee: inherit and ceiling keep it at the length of critical sections, while with none
+it includes the execution of every medium-priority task.
+*/
@@ -0,0 +1,267 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <set>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+using namespace std;
+
+// Proportional-share scheduling: every client (tenant) holds tickets and should get
+// tickets / total_tickets of the CPU. Unlike PrioritySche.cpp nobody starves: a client
+// with 1 ticket out of 1000 still gets 0.1% of the time.
+//
+//   Lottery: every quantum draw a random ticket, its owner runs. A Fenwick tree over the
+//            ticket counts finds the winner and updates counts in O(log n).
+//   Stride:  deterministic. Each client has stride = BIG / tickets and a pass value;
+//            the smallest pass runs and pass += stride. Ordered set of (pass, client).
+//
+// Clients that block before their quantum ends (I/O) would lose share. The fix:
+//   Lottery: compensation tickets, tickets * (quantum / used) until the client wins again
+//   Stride:  advance pass only by stride * used / quantum
+
+typedef long long ll;
+
+const int QUANTUM = 100;        // time units per full quantum
+const ll STRIDE1 = 1LL << 30;   // stride = STRIDE1 / tickets
+
+struct Client
+{
+    ll tickets;
+    int use;     // time units actually used per run (1..QUANTUM), < QUANTUM = I/O bound
+};
+
+// ---------------- Fenwick tree over tickets ----------------
+
+struct Fenwick
+{
+    int n, top;
+    vector<ll> tree;
+
+    Fenwick(int n) : n(n), tree(n + 1, 0)
+    {
+        top = 1;
+        while (top * 2 <= n)
+            top *= 2;
+    }
+
+    void add(int i, ll delta)
+    {
+        for (i++; i <= n; i += i & -i)
+            tree[i] += delta;
+    }
+
+    // Smallest client index whose prefix sum of tickets is > r  (0 <= r < total)
+    int find(ll r)
+    {
+        int pos = 0;
+        for (int step = top; step > 0; step /= 2)
+        {
+            if (pos + step <= n && tree[pos + step] <= r)
+            {
+                pos += step;
+                r -= tree[pos];
+            }
+        }
+        return pos;
+    }
+};
+
+// ---------------- Lottery ----------------
+
+struct Lottery
+{
+    vector<Client> &clients;
+    Fenwick fw;
+    vector<ll> current; // tickets in the tree (base or compensated)
+    ll total = 0;
+    mt19937_64 rng;
+
+    Lottery(vector<Client> &c, unsigned seed) : clients(c), fw(c.size()), current(c.size()), rng(seed)
+    {
+        for (size_t i = 0; i < c.size(); i++)
+            set_current(i, c[i].tickets);
+    }
+
+    void set_current(int i, ll t)
+    {
+        fw.add(i, t - current[i]);
+        total += t - current[i];
+        current[i] = t;
+    }
+
+    // Run one quantum, returns the client and how long it ran
+    int schedule(int &used)
+    {
+        int w = fw.find(rng() % total);
+        used = clients[w].use;
+        // Winner used only part of its quantum -> inflate its tickets until it wins next time
+        set_current(w, clients[w].tickets * QUANTUM / used);
+        return w;
+    }
+
+    void change_tickets(int i, ll t)
+    {
+        ll compensated = current[i] * t / clients[i].tickets; // keep the compensation factor
+        clients[i].tickets = t;
+        set_current(i, compensated);
+    }
+};
+
+// ---------------- Stride ----------------
+
+struct Stride
+{
+    vector<Client> &clients;
+    vector<ll> stride, pass;
+    set<pair<ll, int>> queue; // ordered by pass; begin() = next to run
+
+    Stride(vector<Client> &c) : clients(c), stride(c.size()), pass(c.size())
+    {
+        for (size_t i = 0; i < c.size(); i++)
+        {
+            stride[i] = STRIDE1 / c[i].tickets;
+            pass[i] = stride[i];
+            queue.insert({pass[i], (int)i});
+        }
+    }
+
+    int schedule(int &used)
+    {
+        int w = queue.begin()->second;
+        queue.erase(queue.begin());
+        used = clients[w].use;
+        pass[w] += stride[w] * used / QUANTUM; // partial quantum -> partial stride
+        queue.insert({pass[w], w});
+        return w;
+    }
+
+    // New tickets: scale what is left of the current stride (Waldspurger's "remain")
+    void change_tickets(int i, ll t)
+    {
+        ll global_pass = queue.begin()->first;
+        ll new_stride = STRIDE1 / t;
+        ll remain = pass[i] - global_pass;
+        queue.erase({pass[i], i});
+        pass[i] = global_pass + remain * new_stride / stride[i];
+        stride[i] = new_stride;
+        clients[i].tickets = t;
+        queue.insert({pass[i], i});
+    }
+};
+
+// ---------------- Share accuracy ----------------
+
+struct Phase
+{
+    vector<ll> tickets;  // per client, during this phase
+    vector<ll> lot_cpu;  // time units received under lottery
+    vector<ll> str_cpu;  // ... and under stride
+};
+
+void report_phase(const string &title, const Phase &ph, const vector<Client> &clients, int show)
+{
+    int n = ph.tickets.size();
+    ll tickets = 0, lot_total = 0, str_total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        tickets += ph.tickets[i];
+        lot_total += ph.lot_cpu[i];
+        str_total += ph.str_cpu[i];
+    }
+
+    cout << "\n" << title << "\n";
+    cout << "Client  Tickets  Use   Target %   Lottery %   Stride %\n";
+    double lot_max = 0, str_max = 0, lot_rel = 0, str_rel = 0;
+    for (int i = 0; i < n; i++)
+    {
+        double target = 100.0 * ph.tickets[i] / tickets;
+        double l = 100.0 * ph.lot_cpu[i] / lot_total, s = 100.0 * ph.str_cpu[i] / str_total;
+        lot_max = max(lot_max, fabs(l - target));
+        str_max = max(str_max, fabs(s - target));
+        lot_rel += fabs(l - target) / target;
+        str_rel += fabs(s - target) / target;
+        if (i < show)
+            cout << "C" << left << setw(6) << i << right << setw(8) << ph.tickets[i] << setw(5) << clients[i].use
+                 << fixed << setprecision(4) << setw(11) << target << setw(12) << l << setw(11) << s << endl;
+    }
+    if (n > show)
+        cout << "... (" << n - show << " more)\n";
+    cout << "Max error (percentage points): lottery " << scientific << setprecision(2) << lot_max
+         << ", stride " << str_max << endl;
+    cout << "Mean relative error:           lottery " << fixed << setprecision(4) << 100 * lot_rel / n
+         << "%, stride " << 100 * str_rel / n << "%" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100;
+    ll quanta = argc > 2 ? atoll(argv[2]) : 5000000;
+    unsigned seed = argc > 3 ? atoi(argv[3]) : 1;
+
+    // Tenants: random tickets 1..100, every 4th one is I/O bound and uses only part of a quantum
+    mt19937 rng(seed);
+    vector<Client> base(n);
+    for (int i = 0; i < n; i++)
+        base[i] = {(ll)(rng() % 100 + 1), i % 4 == 3 ? (int)(rng() % (QUANTUM - 10) + 10) : QUANTUM};
+
+    vector<Client> lot_clients = base, str_clients = base;
+    Lottery lottery(lot_clients, seed);
+    Stride stride(str_clients);
+
+    // Phase 1: static tickets. Phase 2: client 0 gets 4x tickets, client 1 drops to 1 ticket.
+    Phase phase[2];
+    double lot_ns = 0, str_ns = 0;
+    for (int ph = 0; ph < 2; ph++)
+    {
+        if (ph == 1)
+        {
+            lottery.change_tickets(0, base[0].tickets * 4);
+            stride.change_tickets(0, base[0].tickets * 4);
+            lottery.change_tickets(1, 1);
+            stride.change_tickets(1, 1);
+        }
+        phase[ph] = {vector<ll>(n), vector<ll>(n, 0), vector<ll>(n, 0)};
+        for (int i = 0; i < n; i++)
+            phase[ph].tickets[i] = lot_clients[i].tickets;
+
+        int used;
+        auto t0 = chrono::steady_clock::now();
+        for (ll q = 0; q < quanta / 2; q++)
+        {
+            int w = lottery.schedule(used);
+            phase[ph].lot_cpu[w] += used;
+        }
+        auto t1 = chrono::steady_clock::now();
+        for (ll q = 0; q < quanta / 2; q++)
+        {
+            int w = stride.schedule(used);
+            phase[ph].str_cpu[w] += used;
+        }
+        auto t2 = chrono::steady_clock::now();
+        lot_ns += chrono::duration<double, nano>(t1 - t0).count();
+        str_ns += chrono::duration<double, nano>(t2 - t1).count();
+    }
+
+    cout << n << " clients, " << quanta << " quanta (" << QUANTUM << " time units each), seed " << seed << endl;
+    cout << "Decision cost: lottery " << fixed << setprecision(1) << lot_ns / quanta << " ns, stride "
+         << str_ns / quanta << " ns per quantum" << endl;
+    report_phase("Phase 1: static tickets (" + to_string(quanta / 2) + " quanta)", phase[0], base, 8);
+    report_phase("Phase 2: C0 tickets x4, C1 down to 1 ticket", phase[1], base, 8);
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 ProportionalShare.cpp -o /tmp/ProportionalShare
+Run:     /tmp/ProportionalShare [clients] [quanta] [seed]
+
+"Target %" = tickets / total tickets = share of CPU TIME the client should get.
+"Use" = time units the client runs before blocking (100 = whole quantum).
+
+Lottery error grows like sqrt(number of quanta) (random), so the share error shrinks like
+1/sqrt(quanta). Stride error is bounded by about one quantum no matter how long it runs.
+Without compensation tickets the I/O-bound clients (Use < 100) would get use/100 of their
+share under lottery; try setting the compensation line to set_current(w, clients[w].tickets).
+*/
@@ -0,0 +1,315 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <climits>
+using namespace std;
+
+// Real-time scheduling of periodic / sporadic tasks on one CPU
+//   EDF (Earliest Deadline First): the ready job with the nearest absolute deadline runs
+//   RM  (Rate Monotonic): fixed priorities, shorter period = higher priority
+// Both are preemptive: a newly released job takes the CPU if it wins.
+// Time is in integer nanoseconds so thousands of small tasks keep exact WCETs.
+
+typedef long long ll;
+const ll INF = LLONG_MAX;
+
+struct Task
+{
+    int id;
+    ll C;          // worst-case execution time
+    ll T;          // period (sporadic: minimum inter-arrival time)
+    ll D;          // relative deadline, D <= T
+    bool sporadic;
+};
+
+struct Result
+{
+    ll jobs = 0, misses = 0, preemptions = 0;
+    vector<ll> lateness; // finish - absolute deadline (negative = early)
+    vector<ll> response; // finish - release
+    double ms = 0;
+};
+
+// ---------------- Admission tests ----------------
+
+double utilization(const vector<Task> &tasks)
+{
+    double u = 0;
+    for (auto &t : tasks)
+        u += (double)t.C / t.T;
+    return u;
+}
+
+double density(const vector<Task> &tasks)
+{
+    double d = 0;
+    for (auto &t : tasks)
+        d += (double)t.C / min(t.D, t.T);
+    return d;
+}
+
+// Liu & Layland: RM schedules any n implicit-deadline tasks with U <= n(2^(1/n) - 1)
+
+double liu_layland_bound(int n)
+{
+    return n * (pow(2.0, 1.0 / n) - 1);
+}
+
+// Hyperbolic bound (Bini): prod(U_i + 1) <= 2 is sufficient for RM, tighter than Liu & Layland
+
+bool hyperbolic_test(const vector<Task> &tasks)
+{
+    double prod = 1;
+    for (auto &t : tasks)
+        prod *= (double)t.C / t.T + 1;
+    return prod <= 2.0;
+}
+
+// Exact response-time analysis for fixed priorities (tasks sorted by period = RM priority):
+//   R = C_i + sum over higher-priority j of ceil(R / T_j) * C_j, iterated to a fixed point.
+// Higher-priority tasks with the same period are merged into one (T, sum of C) entry, so an
+// iteration costs O(distinct periods) instead of O(n).
+// Returns the number of tasks whose worst-case response exceeds their deadline.
+
+int response_time_analysis(const vector<Task> &by_prio, vector<ll> &R)
+{
+    int failed = 0;
+    R.assign(by_prio.size(), 0);
+    vector<pair<ll, ll>> hp; // (period, total WCET) of all higher-priority tasks
+    ll hp_sum = 0;
+    for (size_t i = 0; i < by_prio.size(); i++)
+    {
+        ll r = by_prio[i].C + hp_sum, prev = -1; // every higher-priority task runs at least once
+        while (r != prev && r <= by_prio[i].D)
+        {
+            prev = r;
+            r = by_prio[i].C;
+            for (auto &h : hp)
+                r += (prev + h.first - 1) / h.first * h.second;
+        }
+        R[i] = r;
+        if (r > by_prio[i].D)
+            failed++;
+
+        if (hp.empty() || hp.back().first != by_prio[i].T)
+            hp.push_back({by_prio[i].T, 0});
+        hp.back().second += by_prio[i].C;
+        hp_sum += by_prio[i].C;
+    }
+    return failed;
+}
+
+// ---------------- Simulation ----------------
+
+// Simulate all jobs released in [0, horizon). Jobs that miss keep running (soft real-time),
+// so lateness shows how far behind the system falls.
+
+Result simulate(const vector<Task> &tasks, bool edf, ll horizon, unsigned seed)
+{
+    Result res;
+    mt19937_64 rng(seed);
+    auto t0 = chrono::steady_clock::now();
+
+    struct Job
+    {
+        int task;
+        ll release, deadline, remaining;
+    };
+    vector<Job> jobs;
+
+    // Ready queue: a min-heap of (key, tie-break, job). EDF key = absolute deadline, RM key = period
+    typedef pair<pair<ll, ll>, int> Entry;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> ready;
+    // Next release of every task
+    priority_queue<pair<ll, int>, vector<pair<ll, int>>, greater<pair<ll, int>>> releases;
+    for (auto &t : tasks)
+        releases.push({0, t.id}); // synchronous release: the critical instant
+
+    ll now = 0;
+    int running = -1;
+    while (!releases.empty() || !ready.empty())
+    {
+        if (ready.empty())
+            now = max(now, releases.top().first);
+
+        while (!releases.empty() && releases.top().first <= now)
+        {
+            ll rel = releases.top().first;
+            const Task &t = tasks[releases.top().second];
+            releases.pop();
+
+            jobs.push_back({t.id, rel, rel + t.D, t.C});
+            int j = (int)jobs.size() - 1;
+            if (edf)
+                ready.push({{rel + t.D, t.id}, j});
+            else
+                ready.push({{t.T, t.id}, j});
+
+            ll next = rel + t.T;
+            if (t.sporadic)
+                next += rng() % (t.T / 2 + 1); // arrives any time after the minimum gap
+            if (next < horizon)
+                releases.push({next, t.id});
+        }
+
+        int j = ready.top().second;
+        if (running >= 0 && running != j && jobs[running].remaining > 0)
+            res.preemptions++;
+        running = j;
+
+        // Run until this job finishes or the next release might preempt it
+        ll next_release = releases.empty() ? INF : releases.top().first;
+        ll run = min(jobs[j].remaining, next_release - now);
+        now += run;
+        jobs[j].remaining -= run;
+
+        if (jobs[j].remaining == 0)
+        {
+            ready.pop();
+            res.jobs++;
+            ll late = now - jobs[j].deadline;
+            if (late > 0)
+                res.misses++;
+            res.lateness.push_back(late);
+            res.response.push_back(now - jobs[j].release);
+        }
+    }
+
+    res.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    return res;
+}
+
+ll percentile(vector<ll> &v, double p)
+{
+    if (v.empty())
+        return 0;
+    size_t k = min(v.size() - 1, (size_t)(p / 100.0 * v.size()));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+void report(const char *name, Result r, double unit)
+{
+    cout << left << setw(5) << name << right
+         << setw(10) << r.jobs << setw(9) << r.misses
+         << setw(9) << fixed << setprecision(3) << 100.0 * r.misses / max(1LL, r.jobs) << "%"
+         << setw(12) << r.preemptions;
+    for (double p : {50.0, 90.0, 99.0, 100.0})
+        cout << setw(11) << setprecision(2) << percentile(r.lateness, p) / unit;
+    cout << setw(11) << percentile(r.response, 99.0) / unit
+         << setw(10) << setprecision(1) << r.ms << endl;
+}
+
+void analyse_and_run(vector<Task> tasks, ll horizon, double unit, const char *unit_name, unsigned seed)
+{
+    int n = tasks.size();
+    double U = utilization(tasks);
+    double ll_bound = liu_layland_bound(n);
+
+    vector<Task> by_prio = tasks; // RM priority order
+    stable_sort(by_prio.begin(), by_prio.end(), [](const Task &a, const Task &b) { return a.T < b.T; });
+    vector<ll> R;
+    auto t0 = chrono::steady_clock::now();
+    int rta_failed = response_time_analysis(by_prio, R);
+    double rta_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    cout << "Tasks: " << n << ", utilization U = " << fixed << setprecision(4) << U
+         << ", density = " << density(tasks) << endl;
+    cout << "EDF U <= 1 (exact when D = T):     " << (U <= 1.0 ? "PASS" : "FAIL") << endl;
+    cout << "EDF density <= 1 (any D <= T):     " << (density(tasks) <= 1.0 ? "PASS" : "inconclusive") << endl;
+    cout << "RM  Liu & Layland U <= " << ll_bound << ":  " << (U <= ll_bound ? "PASS" : "inconclusive") << endl;
+    cout << "RM  hyperbolic prod(U_i + 1) <= 2: " << (hyperbolic_test(tasks) ? "PASS" : "inconclusive") << endl;
+    cout << "RM  response-time analysis (exact): " << (rta_failed ? "FAIL" : "PASS")
+         << " (" << rta_failed << " task(s) with R > D, " << setprecision(1) << rta_ms << " ms)" << endl;
+    if (n <= 10)
+    {
+        for (size_t i = 0; i < by_prio.size(); i++)
+            cout << "    T" << by_prio[i].id + 1 << ": C=" << by_prio[i].C / unit << " T=" << by_prio[i].T / unit
+                 << " D=" << by_prio[i].D / unit << "  worst response R " << (R[i] > by_prio[i].D ? string("> D") : "= " + to_string((ll)(R[i] / unit))) << endl;
+    }
+
+    cout << "\nSimulated horizon: " << horizon / unit << " " << unit_name << "  (lateness / response in " << unit_name << ")\n";
+    cout << left << setw(5) << "" << right << setw(10) << "jobs" << setw(9) << "misses" << setw(10) << "miss %"
+         << setw(12) << "preempt" << setw(11) << "late p50" << setw(11) << "late p90" << setw(11) << "late p99"
+         << setw(11) << "late max" << setw(11) << "resp p99" << setw(10) << "sim ms" << endl;
+    report("EDF", simulate(tasks, true, horizon, seed), unit);
+    report("RM", simulate(tasks, false, horizon, seed), unit);
+}
+
+// UUniFast (Bini & Buttazzo): n utilizations that sum to U, uniformly distributed
+
+vector<double> uunifast(int n, double U, mt19937_64 &rng)
+{
+    uniform_real_distribution<double> uni(0, 1);
+    vector<double> u(n);
+    double sum = U;
+    for (int i = 0; i < n - 1; i++)
+    {
+        double next = sum * pow(uni(rng), 1.0 / (n - i - 1));
+        u[i] = sum - next;
+        sum = next;
+    }
+    u[n - 1] = sum;
+    return u;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 10000;
+    double U = argc > 2 ? atof(argv[2]) : 0.9;
+    int sporadic_pct = argc > 3 ? atoi(argv[3]) : 20;
+    unsigned seed = argc > 4 ? atoi(argv[4]) : 1;
+
+    // Textbook set: U = 2/5 + 4/7 = 0.971 > Liu & Layland 0.828. RM misses, EDF does not.
+    cout << "=== Example: T1 (C=2, T=5), T2 (C=4, T=7) ===\n";
+    vector<Task> example = {{0, 2, 5, 5, false}, {1, 4, 7, 7, false}};
+    analyse_and_run(example, 35, 1, "ticks", seed);
+
+    // Random task set: periods from a harmonic-friendly set (hyperperiod 2 s), UUniFast utilizations
+    mt19937_64 rng(seed);
+    const ll MS = 1000000; // 1 ms in ns
+    const ll periods[] = {10, 20, 25, 40, 50, 100, 200, 250, 400, 500, 1000, 2000};
+    vector<double> u = uunifast(n, U, rng);
+    vector<Task> tasks(n);
+    ll H = 1;
+    for (int i = 0; i < n; i++)
+    {
+        ll T = periods[rng() % 12] * MS;
+        ll C = max(1LL, (ll)llround(u[i] * T));
+        bool sporadic = (int)(rng() % 100) < sporadic_pct;
+        ll D = rng() % 4 == 0 ? T - (ll)(rng() % (T / 4)) : T; // a quarter get D < T
+        if (D < C)
+            D = C;
+        tasks[i] = {i, C, T, D, sporadic};
+        H = lcm(H, T);
+    }
+
+    cout << "\n=== Random set: " << n << " tasks, target U = " << U << ", " << sporadic_pct << "% sporadic, seed " << seed << " ===\n";
+    analyse_and_run(tasks, H, MS, "ms", seed);
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -std=c++17 RealTime.cpp -o /tmp/RealTime
+Run:     /tmp/RealTime [tasks] [utilization] [sporadic %] [seed]
+Example: /tmp/RealTime 10000 0.95 20 1
+
+Hyperperiod = lcm of all periods: after it the synchronous pattern of periodic releases
+repeats, so one hyperperiod is enough to see every deadline miss of a periodic task set.
+
+Admission tests
+    EDF:  U <= 1 is exact when D = T. With D < T, density = sum C/D <= 1 is sufficient.
+    RM:   U <= n(2^(1/n) - 1) (-> 0.693 for large n) and prod(U_i + 1) <= 2 are sufficient,
+          response-time analysis is exact (worst case = all tasks released together).
+
+Lateness = finish - deadline. Negative = finished early; positive = deadline miss.
+RM with D < T uses period order, which is not optimal (deadline monotonic would be).
+*/
@@ -1,4 +1,5 @@
 #include <bits/stdc++.h>
+#include "../Thread/PerfRegion.h"
 using namespace std;
 const int MAX = 10;
 
@@ -15,35 +16,38 @@ void round_robin(int n, int bt[], int p[], int qt)
     int curr_time = 0;
     int completed = 0;
 
-    while (completed < n)
     {
-        bool done = true;
-        for (int i = 0; i < n; i++)
+        PerfRegion region("round_robin"); // the scheduling loop only, not the output
+        while (completed < n)
         {
-            if (bt[i] > 0)
+            bool done = true;
+            for (int i = 0; i < n; i++)
             {
-                done = false;
-                wt[i] += curr_time - last[i];
-
-                if (bt[i] <= qt)
-                {
-                    curr_time += bt[i];
-                    bt[i] = 0;
-                    completed++;
-                }
-
-                else
+                if (bt[i] > 0)
                 {
-                    curr_time += qt;
-                    bt[i] -= qt;
+                    done = false;
+                    wt[i] += curr_time - last[i];
+
+                    if (bt[i] <= qt)
+                    {
+                        curr_time += bt[i];
+                        bt[i] = 0;
+                        completed++;
+                    }
+
+                    else
+                    {
+                        curr_time += qt;
+                        bt[i] -= qt;
+                    }
+
+                    last[i] = curr_time;
                 }
-
-                last[i] = curr_time;
             }
-        }
 
-        if (done)
-            break;
+            if (done)
+                break;
+        }
     }
 
     for (int i = 0; i < n; i++)
@@ -0,0 +1,221 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>        // fork(), vfork(), pipe()
+#include <sys/wait.h>      // waitpid()
+#include <sys/mman.h>      // mmap(), madvise()
+#include <sys/resource.h>  // getrusage(): minor / major page faults
+#include <spawn.h>         // posix_spawn()
+
+using namespace std;
+
+extern char **environ;
+
+// What does fork() really cost for a big process?
+// ProcessCreation.cpp forks an almost empty program, so fork() looks free. Here the parent
+// first builds a heap of a chosen size, then forks, and the child writes to part of it.
+// Every written page is copied by the kernel (copy-on-write), so we measure:
+//   - fork latency in the parent (copying page tables)
+//   - page faults in the child (getrusage minor / major faults)
+//   - COW write amplification = bytes the kernel copied / bytes the child actually wrote
+
+#ifndef MADV_WIPEONFORK
+#define MADV_WIPEONFORK 18
+#endif
+
+typedef chrono::steady_clock Clock;
+
+const size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+// Read "Key:   1234 kB" from /proc/self/smaps_rollup
+
+long smaps_kb(const char *key) {
+    ifstream in("/proc/self/smaps_rollup");
+    string line;
+    size_t len = strlen(key);
+    while (getline(in, line)) {
+        if (line.compare(0, len, key) == 0 && line[len] == ':')
+            return atol(line.c_str() + len + 1);
+    }
+    return -1;
+}
+
+// What the child sends back through a pipe
+
+struct ChildReport {
+    long minor_faults;
+    long major_faults;
+    long private_dirty_kb; // memory that now belongs only to the child (= copied pages)
+    long bytes_written;
+    double dirty_ms;
+    bool heap_mapped;      // false with MADV_DONTFORK
+    bool saw_zeroes;       // true with MADV_WIPEONFORK
+};
+
+// Child: write one byte every 'stride' bytes over the first 'dirty_pct' percent of the heap
+
+ChildReport child_work(char *heap, size_t heap_bytes, int dirty_pct, size_t stride) {
+    ChildReport r {};
+    rusage before, after;
+
+    // A MADV_DONTFORK region is simply not mapped in the child
+    unsigned char resident;
+    r.heap_mapped = mincore(heap, 4096, &resident) == 0;
+    if (!r.heap_mapped) return r;
+    r.saw_zeroes = heap[0] == 0; // parent filled it with 1s
+
+    long private_before = smaps_kb("Private_Dirty");
+    getrusage(RUSAGE_SELF, &before);
+    auto t0 = Clock::now();
+
+    size_t limit = heap_bytes / 100 * dirty_pct;
+    for (size_t off = 0; off < limit; off += stride) {
+        heap[off] = 2;
+        r.bytes_written++;
+    }
+
+    r.dirty_ms = chrono::duration<double, milli>(Clock::now() - t0).count();
+    getrusage(RUSAGE_SELF, &after);
+    r.minor_faults = after.ru_minflt - before.ru_minflt;
+    r.major_faults = after.ru_majflt - before.ru_majflt;
+    r.private_dirty_kb = smaps_kb("Private_Dirty") - private_before;
+    return r;
+}
+
+// Parent heap: 2 MB aligned so transparent huge pages can be used.
+// raw = the whole mapping (bytes + HUGE_PAGE), to be unmapped afterwards
+
+char *make_heap(size_t bytes, const string &mode, char *&raw) {
+    raw = (char *)mmap(NULL, bytes + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        cerr << "mmap failed!" << endl;
+        exit(1);
+    }
+    char *heap = (char *)(((uintptr_t)raw + HUGE_PAGE - 1) & ~(uintptr_t)(HUGE_PAGE - 1));
+
+    madvise(heap, bytes, mode == "thp" ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+    if (mode == "dontfork") madvise(heap, bytes, MADV_DONTFORK);
+    if (mode == "wipeonfork") madvise(heap, bytes, MADV_WIPEONFORK);
+
+    memset(heap, 1, bytes); // touch everything: the parent really owns this memory
+    return heap;
+}
+
+void run(const string &mode, size_t heap_mb, int dirty_pct, size_t stride) {
+    size_t bytes = heap_mb * 1024 * 1024;
+    char *raw;
+    char *heap = make_heap(bytes, mode, raw);
+    long huge_kb = smaps_kb("AnonHugePages");
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        cerr << "pipe failed!" << endl;
+        exit(1);
+    }
+
+    ChildReport rep {};
+    auto t0 = Clock::now();
+    pid_t pid;
+    double create_ms, wait_ms;
+
+    if (mode == "vfork") {
+        pid = vfork(); // parent sleeps until the child calls _exit(); nothing is copied
+        if (pid == 0) _exit(0);
+        create_ms = chrono::duration<double, milli>(Clock::now() - t0).count();
+    }
+    else if (mode == "spawn") {
+        char *args[] = {(char *)"/bin/true", NULL};
+        if (posix_spawn(&pid, "/bin/true", NULL, NULL, args, environ) != 0) pid = -1;
+        create_ms = chrono::duration<double, milli>(Clock::now() - t0).count();
+    }
+    else {
+        pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            ChildReport r = child_work(heap, bytes, dirty_pct, stride);
+            if (write(fds[1], &r, sizeof(r)) != sizeof(r)) _exit(1);
+            _exit(0);
+        }
+        create_ms = chrono::duration<double, milli>(Clock::now() - t0).count();
+    }
+    close(fds[1]);
+
+    if (pid < 0) {
+        cerr << mode << ": process creation failed" << endl;
+        exit(1);
+    }
+
+    bool got_report = read(fds[0], &rep, sizeof(rep)) == sizeof(rep);
+    close(fds[0]);
+    auto t1 = Clock::now();
+    waitpid(pid, NULL, 0); // includes tearing down the child's copy of the page tables
+    wait_ms = chrono::duration<double, milli>(Clock::now() - t1).count();
+
+    cout << left << setw(11) << mode << right << fixed << setprecision(3)
+         << setw(11) << create_ms << setw(10) << wait_ms
+         << setw(10) << huge_kb / 1024;
+
+    if (!got_report) {
+        cout << "        (child does not touch the heap)" << endl;
+    }
+    else if (!rep.heap_mapped) {
+        cout << "        (heap not mapped in child: MADV_DONTFORK)" << endl;
+    }
+    else {
+        double written_kb = rep.bytes_written / 1024.0;
+        cout << setw(10) << rep.minor_faults << setw(7) << rep.major_faults
+             << setw(11) << setprecision(1) << rep.dirty_ms
+             << setw(12) << rep.private_dirty_kb / 1024
+             << setw(12) << setprecision(0) << (written_kb > 0 ? rep.private_dirty_kb / written_kb : 0) << "x"
+             << (rep.saw_zeroes ? "  (child saw zero-filled heap: MADV_WIPEONFORK)" : "") << endl;
+    }
+
+    munmap(raw, bytes + HUGE_PAGE);
+}
+
+int main(int argc, char *argv[]) {
+    size_t heap_mb = argc > 1 ? atol(argv[1]) : 512;
+    string mode = argc > 2 ? argv[2] : "all";
+    int dirty_pct = argc > 3 ? atoi(argv[3]) : 10;
+    size_t stride = argc > 4 ? atol(argv[4]) : 4096;
+    if (dirty_pct < 0) dirty_pct = 0;
+    if (dirty_pct > 100) dirty_pct = 100;
+    if (stride < 1) stride = 1;
+
+    cout << "Parent heap: " << heap_mb << " MB, child dirties " << dirty_pct << "% of it, 1 byte every " << stride << " bytes\n" << endl;
+    cout << left << setw(11) << "Mode" << right
+         << setw(11) << "create ms" << setw(10) << "wait ms" << setw(10) << "THP MB"
+         << setw(10) << "minflt" << setw(7) << "majflt" << setw(11) << "dirty ms"
+         << setw(12) << "copied MB" << setw(13) << "amplif." << endl;
+
+    vector<string> modes;
+    if (mode == "all") modes = {"fork", "thp", "dontfork", "wipeonfork", "vfork", "spawn"};
+    else modes = {mode};
+
+    for (auto &m : modes)
+        run(m, heap_mb, dirty_pct, stride);
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 ForkCowAnalyzer.cpp -o /tmp/ForkCowAnalyzer
+Run:     /tmp/ForkCowAnalyzer [heap MB] [mode|all] [dirty %] [write stride bytes]
+Modes:   fork        plain fork(), heap in 4 KB pages
+         thp         heap marked MADV_HUGEPAGE (2 MB pages -> fewer page tables to copy)
+         dontfork    MADV_DONTFORK: heap is not inherited at all
+         wipeonfork  MADV_WIPEONFORK: child gets the range, but zero-filled
+         vfork       no copy; parent blocked until the child _exit()s / exec()s
+         spawn       posix_spawn("/bin/true"), the usual replacement for fork + exec
+
+Copy-on-write: after fork() parent and child share every page read-only. The first write
+to a page faults (minflt) and the kernel copies the WHOLE page. Writing 1 byte per 4 KB page
+copies 4096 bytes -> amplification 4096x. With a larger stride nothing changes per page;
+with stride 1 amplification approaches 1x. "copied MB" = growth of the child's Private_Dirty.
+*/
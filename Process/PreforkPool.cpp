@@ -0,0 +1,493 @@
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <csignal>
+#include <unistd.h>        // fork(), getpid()
+#include <sys/wait.h>      // waitpid()
+#include <sys/mman.h>      // mmap(MAP_SHARED)
+#include <sys/syscall.h>   // SYS_futex
+#include <linux/futex.h>   // FUTEX_WAIT, FUTEX_WAKE
+
+using namespace std;
+
+// Pre-forked worker pool.
+// MultipleChild.cpp forks one child per task and the child exits right away.
+// Here the parent forks N long-lived workers once; jobs go to them through a ring buffer
+// in a MAP_SHARED region and sleeping workers are woken with a futex.
+// If a worker crashes the parent notices (waitpid WNOHANG) and forks a replacement.
+
+// ---------------- Futex helpers ----------------
+
+// No FUTEX_PRIVATE_FLAG: the futex word lives in memory shared between processes
+
+void futex_wait(atomic<uint32_t> *addr, uint32_t expected, long timeout_ns) {
+    timespec ts = {timeout_ns / 1000000000, timeout_ns % 1000000000};
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAIT, expected, timeout_ns > 0 ? &ts : NULL, NULL, 0);
+}
+
+void futex_wake(atomic<uint32_t> *addr, int count) {
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+// ---------------- Lock-free ring ----------------
+
+// Bounded ring after Vyukov's MPMC queue. Each cell has a sequence number that says whether
+// it is ready to be written (seq == pos) or read (seq == pos + 1).
+// Only lock-free atomics are used, so it works across processes in shared memory.
+//
+// The parent is the only producer of the job ring and the only consumer of the result ring;
+// workers are on the other side and can be killed at any instruction. So a worker does not
+// take a cell by moving the shared position first: it claims the cell itself by CASing its
+// seq to a CLAIMED marker with its worker id, then advances the position (anybody who sees a
+// claimed cell helps advance it), then finishes and releases the cell. If it dies in between,
+// the marker still names it and the parent repairs the cell after reaping it.
+
+const uint64_t CLAIMED = 1ULL << 63;
+const uint64_t POS_MASK = (1ULL << 48) - 1;
+
+inline uint64_t claim_mark(int who, uint64_t pos) { return CLAIMED | ((uint64_t)who << 48) | (pos & POS_MASK); }
+inline int claim_owner(uint64_t seq) { return (int)((seq & ~CLAIMED) >> 48); }
+inline uint64_t claim_pos(uint64_t seq) { return seq & POS_MASK; }
+
+template <typename T, int SIZE>
+struct Ring {
+    struct Cell {
+        atomic<uint64_t> seq;
+        T data;
+    };
+
+    alignas(64) atomic<uint64_t> enqueue_pos;
+    alignas(64) atomic<uint64_t> dequeue_pos;
+    alignas(64) Cell cells[SIZE];
+
+    void init() {
+        for (int i = 0; i < SIZE; i++)
+            cells[i].seq.store(i, memory_order_relaxed);
+        enqueue_pos.store(0, memory_order_relaxed);
+        dequeue_pos.store(0, memory_order_relaxed);
+    }
+
+    // Single producer (parent)
+    bool push(const T &item) {
+        uint64_t pos = enqueue_pos.load(memory_order_relaxed);
+        Cell &c = cells[pos % SIZE];
+        uint64_t seq = c.seq.load(memory_order_acquire);
+        if (seq != pos) return false; // full: not consumed yet, or still claimed by a consumer
+        c.data = item;
+        enqueue_pos.store(pos + 1, memory_order_relaxed);
+        c.seq.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    // Single consumer (parent)
+    bool pop(T &item) {
+        uint64_t pos = dequeue_pos.load(memory_order_relaxed);
+        Cell &c = cells[pos % SIZE];
+        if (c.seq.load(memory_order_acquire) != pos + 1) return false; // empty, or a producer is still writing
+        item = c.data;
+        dequeue_pos.store(pos + 1, memory_order_relaxed);
+        c.seq.store(pos + SIZE, memory_order_release);
+        return true;
+    }
+
+    // Producer that may die (worker 'who'): claim, advance, write, publish
+    bool push_claimed(const T &item, int who) {
+        uint64_t pos = enqueue_pos.load(memory_order_relaxed);
+        while (true) {
+            Cell &c = cells[pos % SIZE];
+            uint64_t seq = c.seq.load(memory_order_acquire);
+            if (seq & CLAIMED) {
+                if (claim_pos(seq) != (pos & POS_MASK)) return false; // last lap still being written: full
+                enqueue_pos.compare_exchange_strong(pos, pos + 1, memory_order_relaxed); // help
+                pos = enqueue_pos.load(memory_order_relaxed);
+            } else if (seq == pos) {
+                if (c.seq.compare_exchange_weak(seq, claim_mark(who, pos), memory_order_acquire)) {
+                    uint64_t expected = pos;
+                    enqueue_pos.compare_exchange_strong(expected, pos + 1, memory_order_relaxed);
+                    c.data = item;
+                    c.seq.store(pos + 1, memory_order_release);
+                    return true;
+                }
+                pos = enqueue_pos.load(memory_order_relaxed);
+            } else if ((int64_t)(seq - pos) < 0) {
+                return false; // full
+            } else {
+                pos = enqueue_pos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer that may die (worker 'who'): claim, advance, read, then publish(item) records
+    // the item somewhere the parent can see before the cell is released
+    template <typename F>
+    bool pop_claimed(T &item, int who, F publish) {
+        uint64_t pos = dequeue_pos.load(memory_order_relaxed);
+        while (true) {
+            Cell &c = cells[pos % SIZE];
+            uint64_t seq = c.seq.load(memory_order_acquire);
+            if (seq & CLAIMED) {
+                if (claim_pos(seq) != (pos & POS_MASK)) return false; // last lap still being read: empty
+                dequeue_pos.compare_exchange_strong(pos, pos + 1, memory_order_relaxed); // help
+                pos = dequeue_pos.load(memory_order_relaxed);
+            } else if (seq == pos + 1) {
+                if (c.seq.compare_exchange_weak(seq, claim_mark(who, pos), memory_order_acquire)) {
+                    uint64_t expected = pos;
+                    dequeue_pos.compare_exchange_strong(expected, pos + 1, memory_order_relaxed);
+                    item = c.data;
+                    publish(item);
+                    c.seq.store(pos + SIZE, memory_order_release);
+                    return true;
+                }
+                pos = dequeue_pos.load(memory_order_relaxed);
+            } else if ((int64_t)(seq - (pos + 1)) < 0) {
+                return false; // empty
+            } else {
+                pos = dequeue_pos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    // Parent, after reaping dead worker 'who': release the cell it had claimed in pop_claimed().
+    // Returns true and the item it took (it may already be in current_job, but never ran).
+    bool recover_pop(int who, T &item) {
+        for (int i = 0; i < SIZE; i++) {
+            uint64_t seq = cells[i].seq.load(memory_order_acquire);
+            if (!(seq & CLAIMED) || claim_owner(seq) != who) continue;
+            uint64_t pos = claim_pos(seq);
+            item = cells[i].data;
+            dequeue_pos.compare_exchange_strong(pos, pos + 1, memory_order_relaxed);
+            cells[i].seq.store(claim_pos(seq) + SIZE, memory_order_release);
+            return true;
+        }
+        return false;
+    }
+
+    // Parent, after reaping dead worker 'who': the cell it claimed in push_claimed() may hold
+    // half an item, publish 'filler' in it instead so the consumer can move past it
+    void recover_push(int who, const T &filler) {
+        for (int i = 0; i < SIZE; i++) {
+            uint64_t seq = cells[i].seq.load(memory_order_acquire);
+            if (!(seq & CLAIMED) || claim_owner(seq) != who) continue;
+            uint64_t pos = claim_pos(seq);
+            cells[i].data = filler;
+            enqueue_pos.compare_exchange_strong(pos, pos + 1, memory_order_relaxed);
+            cells[i].seq.store(claim_pos(seq) + 1, memory_order_release);
+            return;
+        }
+    }
+};
+
+// ---------------- Shared region ----------------
+
+const int RING_SIZE = 4096;
+const int MAX_WORKERS = 64;
+const long long CRASH_JOB = -1; // input that makes a worker crash (to test respawn)
+
+struct Job {
+    long long id;
+    long long input;
+};
+
+struct Result {
+    long long id;
+    long long output;
+    int worker;
+    bool crashed;
+};
+
+struct WorkerSlot {
+    atomic<long long> current_job; // job being processed, -1 if idle
+    pid_t pid;
+};
+
+struct Shared {
+    Ring<Job, RING_SIZE> jobs;
+    Ring<Result, RING_SIZE> results;
+
+    alignas(64) atomic<uint32_t> job_seq;       // futex: bumped on every new job
+    atomic<uint64_t> sleeping_workers;         // bit per worker id, so a dead worker's bit can be cleared
+    alignas(64) atomic<uint32_t> result_seq;    // futex: bumped on every new result
+    atomic<uint32_t> parent_sleeping;
+    alignas(64) atomic<bool> shutdown;
+
+    WorkerSlot workers[MAX_WORKERS];
+};
+
+Shared *shm = NULL;
+
+// ---------------- Worker side ----------------
+
+long long do_work(long long input) {
+    if (input == CRASH_JOB) abort(); // simulated bug
+
+    // Small CPU job: sum of 1..input with a little mixing
+    long long x = 0;
+    for (long long i = 1; i <= input; i++)
+        x += i ^ (x >> 3);
+    return x;
+}
+
+// current_job is set while the job's cell is still claimed (see Ring::pop_claimed), so at
+// every instant the job is either in the ring, claimed in a cell, or in current_job
+
+bool take_job(int id, Job &job) {
+    WorkerSlot &me = shm->workers[id];
+    return shm->jobs.pop_claimed(job, id, [&](const Job &j) { me.current_job.store(j.id, memory_order_release); });
+}
+
+void process_job(int id, const Job &job) {
+    WorkerSlot &me = shm->workers[id];
+
+    Result r {job.id, do_work(job.input), id, false};
+    while (!shm->results.push_claimed(r, id)) usleep(50); // parent is behind -> back off
+
+    me.current_job.store(-1, memory_order_release);
+
+    shm->result_seq.fetch_add(1, memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst); // pairs with the fence in the parent's sleep path
+    if (shm->parent_sleeping.load(memory_order_relaxed))
+        futex_wake(&shm->result_seq, 1);
+}
+
+void worker_loop(int id) {
+    while (true) {
+        Job job;
+        if (take_job(id, job)) {
+            process_job(id, job);
+            continue;
+        }
+
+        if (shm->shutdown.load(memory_order_acquire)) return;
+
+        // Nothing to do: announce we are going to sleep, re-check, then wait on the futex.
+        // The fence makes sure either we see the parent's new job or the parent sees us sleeping.
+        uint32_t seq = shm->job_seq.load(memory_order_acquire);
+        shm->sleeping_workers.fetch_or(1ULL << id, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        bool got = take_job(id, job);
+        if (!got && !shm->shutdown.load(memory_order_acquire))
+            futex_wait(&shm->job_seq, seq, 0);
+        shm->sleeping_workers.fetch_and(~(1ULL << id), memory_order_relaxed);
+
+        if (got) process_job(id, job);
+    }
+}
+
+pid_t spawn_worker(int id) {
+    shm->workers[id].current_job.store(-1);
+    pid_t pid = fork();
+    if (pid < 0) {
+        cerr << "Fork failed!" << endl;
+        exit(1);
+    }
+    if (pid == 0) {
+        worker_loop(id);
+        _exit(0);
+    }
+    shm->workers[id].pid = pid;
+    return pid;
+}
+
+// ---------------- Parent side ----------------
+
+struct Stats {
+    long long done = 0;
+    long long failed = 0;
+    long long checksum = 0;
+    int respawned = 0;
+    int requeued = 0;
+};
+
+const Result FILLER = {-1, 0, -1, false}; // stands in for a result whose writer died
+
+// Record a result once (a crash right after pushing a result could report a job twice)
+
+void record(const Result &r, vector<char> &finished, Stats &st) {
+    if (r.id < 0 || finished[r.id]) return;
+    finished[r.id] = 1;
+    st.done++;
+    if (r.crashed) st.failed++;
+    else st.checksum += r.output;
+}
+
+// Reap dead workers without blocking, repair the ring cells they had claimed, fail their
+// in-flight job (or re-queue it if they died before starting it) and fork a replacement
+
+void check_workers(int num_workers, vector<char> &finished, vector<Job> &retry, Stats &st) {
+    int status;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        for (int id = 0; id < num_workers; id++) {
+            if (shm->workers[id].pid != pid) continue;
+
+            long long job = shm->workers[id].current_job.load(memory_order_acquire);
+            Job taken;
+            if (shm->jobs.recover_pop(id, taken)) { // died while taking a job: never ran it
+                retry.push_back(taken);
+                st.requeued++;
+                if (job == taken.id) job = -1;
+            }
+            shm->results.recover_push(id, FILLER);
+            shm->sleeping_workers.fetch_and(~(1ULL << id), memory_order_relaxed); // killed while parked
+            if (job >= 0) record(Result {job, 0, id, true}, finished, st);
+
+            if (WIFSIGNALED(status))
+                cout << "Worker " << id << " (PID " << pid << ") killed by signal " << WTERMSIG(status) << ", respawning" << endl;
+            spawn_worker(id);
+            st.respawned++;
+        }
+    }
+}
+
+void wake_workers(int count) {
+    shm->job_seq.fetch_add(1, memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst); // pairs with the fence in worker_loop()
+    if (shm->sleeping_workers.load(memory_order_relaxed) != 0)
+        futex_wake(&shm->job_seq, count);
+}
+
+Stats run_pool(int num_workers, long long num_jobs, long long work, bool inject_crash, int kills) {
+    Stats st;
+    vector<char> finished(num_jobs, 0);
+    vector<Job> retry; // taken by a worker that died before running them
+    srand(getpid());
+
+    for (int id = 0; id < num_workers; id++)
+        spawn_worker(id);
+
+    long long next = 0;
+    int killed = 0;
+    while (st.done < num_jobs) {
+        // Test mode: SIGKILL a random worker at evenly spaced points of the run
+        if (killed < kills && st.done >= num_jobs * (killed + 1) / (kills + 1)) {
+            kill(shm->workers[rand() % num_workers].pid, SIGKILL);
+            killed++;
+        }
+
+        // 1) Hand out as many jobs as fit in the ring, re-queued ones first
+        int pushed = 0;
+        while (!retry.empty() && shm->jobs.push(retry.back())) {
+            retry.pop_back();
+            pushed++;
+        }
+        while (retry.empty() && next < num_jobs) {
+            long long input = (inject_crash && next == num_jobs / 2) ? CRASH_JOB : work;
+            if (!shm->jobs.push(Job {next, input})) break;
+            next++;
+            pushed++;
+        }
+        if (pushed) wake_workers(pushed < num_workers ? pushed : num_workers);
+
+        // 2) Collect finished results
+        Result r;
+        int collected = 0;
+        while (shm->results.pop(r)) {
+            record(r, finished, st);
+            collected++;
+        }
+
+        // 3) Nothing happened -> sleep until a result arrives (or 10 ms to check for crashes)
+        if (!pushed && !collected) {
+            uint32_t seq = shm->result_seq.load(memory_order_acquire);
+            shm->parent_sleeping.store(1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            if (!shm->results.pop(r))
+                futex_wait(&shm->result_seq, seq, 10000000);
+            else
+                record(r, finished, st);
+            shm->parent_sleeping.store(0, memory_order_release);
+            check_workers(num_workers, finished, retry, st);
+        }
+    }
+
+    // Shut down: wake everyone so they see the flag and exit
+    shm->shutdown.store(true, memory_order_release);
+    shm->job_seq.fetch_add(1);
+    futex_wake(&shm->job_seq, INT_MAX);
+    for (int id = 0; id < num_workers; id++)
+        waitpid(shm->workers[id].pid, NULL, 0);
+
+    return st;
+}
+
+// Baseline: fork one child per job, like MultipleChild.cpp
+
+double fork_per_job(long long num_jobs, long long work) {
+    auto t0 = chrono::steady_clock::now();
+    for (long long i = 0; i < num_jobs; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            do_work(work);
+            _exit(0);
+        }
+        waitpid(pid, NULL, 0);
+    }
+    return num_jobs / chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char *argv[]) {
+    int num_workers = argc > 1 ? atoi(argv[1]) : 4;
+    long long num_jobs = argc > 2 ? atoll(argv[2]) : 1000000;
+    long long work = argc > 3 ? atoll(argv[3]) : 10;
+    int kills = argc > 4 ? atoi(argv[4]) : 0;
+    if (num_workers < 1) num_workers = 1;
+    if (num_workers > MAX_WORKERS) num_workers = MAX_WORKERS;
+
+    void *mem = mmap(NULL, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        cerr << "mmap failed!" << endl;
+        return 1;
+    }
+    shm = new (mem) Shared();
+    shm->jobs.init();
+    shm->results.init();
+
+    cout << "Parent PID: " << getpid() << ", workers: " << num_workers << ", jobs: " << num_jobs << endl;
+
+    auto t0 = chrono::steady_clock::now();
+    Stats st = run_pool(num_workers, num_jobs, work, true, kills);
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    cout << "\nPre-forked pool:" << endl;
+    cout << "  jobs done      : " << st.done << " (" << st.failed << " failed because a worker crashed)" << endl;
+    cout << "  respawned      : " << st.respawned << " worker(s), " << st.requeued << " job(s) re-queued" << endl;
+    bool sum_ok = st.checksum == (st.done - st.failed) * do_work(work);
+    cout << "  checksum       : " << st.checksum << (sum_ok ? " (ok)" : " (WRONG)") << endl;
+    cout << "  throughput     : " << (long long)(st.done / secs) << " jobs/sec" << endl;
+
+    long long baseline_jobs = num_jobs < 2000 ? num_jobs : 2000;
+    cout << "\nfork() per job (" << baseline_jobs << " jobs):" << endl;
+    cout << "  throughput     : " << (long long)fork_per_job(baseline_jobs, work) << " jobs/sec" << endl;
+
+    munmap(mem, sizeof(Shared));
+    return 0;
+}
+
+/*
+Compile: g++ -O2 PreforkPool.cpp -o /tmp/PreforkPool
+Run:     /tmp/PreforkPool [workers] [jobs] [work per job] [kills]
+         /tmp/PreforkPool 4 2000000 300 40      (SIGKILL 40 random workers during the run)
+
+Shared memory layout (one mmap(MAP_SHARED | MAP_ANONYMOUS) made BEFORE fork(),
+so every worker sees the same physical pages):
+    jobs ring     parent -> workers
+    results ring  workers -> parent
+    job_seq       futex word workers sleep on
+    result_seq    futex word the parent sleeps on
+    workers[]     pid + job currently being processed
+
+A futex is only called when someone is actually sleeping, so at full load jobs flow
+through the rings with no system calls at all.
+
+Crash handling: one job (CRASH_JOB) calls abort(). The parent reaps the dead worker with
+waitpid(WNOHANG), reports its in-flight job as failed and forks a new worker.
+A worker can also die in the middle of a ring operation (the kills test mode). Its claimed
+cell still carries its id, so the parent releases it: a job it was taking goes back into
+the ring (it never ran), a result it was writing is replaced by a filler the parent skips.
+Without this the cell stays taken forever and the ring stops at it.
+*/
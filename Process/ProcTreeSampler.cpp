@@ -0,0 +1,351 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <unordered_map>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>         // fork(), pread(), sysconf()
+#include <fcntl.h>          // openat()
+#include <sys/wait.h>
+#include <sys/prctl.h>      // PR_SET_CHILD_SUBREAPER
+#include <sys/resource.h>
+#include <sys/syscall.h>    // SYS_getdents64
+
+using namespace std;
+
+// Automated version of "run ps -l and look for Z" from ZombieProcess.cpp / OrphanProcess.cpp.
+// Samples a process subtree from /proc at a fixed rate and reports state, ppid changes
+// (orphans being re-parented), CPU time, RSS and zombie counts.
+//
+// Kept cheap on purpose:
+//   - /proc is opened once; everything else is openat() relative to it
+//   - each process's stat file stays open and is re-read with pread() (no open/close per sample)
+//   - one read buffer is reused for every file
+//   - only differences against the previous sample are reported
+
+// ---------------- Per-process state ----------------
+
+struct Proc {
+    int stat_fd = -1;
+    int children_fd = -1; // /proc/<pid>/task/<pid>/children, -1 if the kernel lacks it
+    char state = '?';
+    int ppid = 0;
+    long long cpu_ticks = 0; // utime + stime
+    long rss_pages = 0;
+};
+
+int proc_fd = -1;
+unordered_map<int, Proc> procs;
+char buf[64 * 1024]; // reused for every read
+bool have_children_files = true; // probed once in main(), on our own pid
+
+long long now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Parse "pid (comm) S ppid pgrp ... utime stime ... rss ..." (see man 5 proc)
+
+bool parse_stat(const char *text, Proc &p) {
+    const char *s = strrchr(text, ')'); // comm may contain spaces and ')'
+    if (!s) return false;
+    s += 2;
+
+    p.state = *s;
+    long long field[25] = {0};
+    int idx = 3;
+    char *end;
+    s++;
+    while (idx < 24 && *s) {
+        field[++idx] = strtoll(s, &end, 10);
+        if (end == s) break;
+        s = end;
+    }
+    p.ppid = (int)field[4];
+    p.cpu_ticks = field[14] + field[15];
+    p.rss_pages = field[24];
+    return true;
+}
+
+// Re-read the stat file through the already open fd. Fails once the process is gone.
+
+bool refresh(Proc &p) {
+    ssize_t n = pread(p.stat_fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return false;
+    buf[n] = 0;
+    return parse_stat(buf, p);
+}
+
+// Start tracking a pid: open its files relative to /proc
+
+bool track(int pid) {
+    if (procs.count(pid)) return true;
+
+    char path[64];
+    snprintf(path, sizeof(path), "%d/stat", pid);
+    int fd = openat(proc_fd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    Proc p;
+    p.stat_fd = fd;
+    if (have_children_files) {
+        snprintf(path, sizeof(path), "%d/task/%d/children", pid, pid);
+        p.children_fd = openat(proc_fd, path, O_RDONLY | O_CLOEXEC);
+        if (p.children_fd < 0 && errno == ENOENT) { // the kernel has the file: this pid just exited
+            close(fd);
+            return false;
+        }
+    }
+    if (!refresh(p)) {
+        close(fd);
+        if (p.children_fd >= 0) close(p.children_fd);
+        return false;
+    }
+    procs[pid] = p;
+    return true;
+}
+
+// ---------------- Discovery ----------------
+
+// Fast path: follow /proc/<pid>/task/<pid>/children from the root down
+
+void discover_children(int root) {
+    vector<int> stack = {root};
+    while (!stack.empty()) {
+        int pid = stack.back();
+        stack.pop_back();
+        auto it = procs.find(pid);
+        if (it == procs.end() || it->second.children_fd < 0) continue;
+
+        ssize_t n = pread(it->second.children_fd, buf, sizeof(buf) - 1, 0);
+        if (n <= 0) continue;
+        buf[n] = 0;
+
+        vector<int> kids;
+        char *s = buf, *end;
+        while (true) {
+            long child = strtol(s, &end, 10);
+            if (end == s) break;
+            kids.push_back((int)child);
+            s = end;
+        }
+        for (int child : kids) {
+            if (track(child)) stack.push_back(child);
+        }
+    }
+}
+
+// Fallback: scan all of /proc with getdents64 and follow ppid links into the subtree
+
+struct linux_dirent64 {
+    unsigned long long d_ino;
+    long long d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+void discover_scan(int root) {
+    static char dents[256 * 1024];
+    vector<pair<int, int>> all; // (pid, ppid)
+    Proc tmp;
+
+    lseek(proc_fd, 0, SEEK_SET);
+    while (true) {
+        long n = syscall(SYS_getdents64, proc_fd, dents, sizeof(dents));
+        if (n <= 0) break;
+        for (long off = 0; off < n;) {
+            linux_dirent64 *d = (linux_dirent64 *)(dents + off);
+            off += d->d_reclen;
+            if (d->d_name[0] < '0' || d->d_name[0] > '9') continue;
+
+            int pid = atoi(d->d_name);
+            char path[64];
+            snprintf(path, sizeof(path), "%d/stat", pid);
+            int fd = openat(proc_fd, path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) continue;
+            ssize_t r = read(fd, buf, sizeof(buf) - 1);
+            close(fd);
+            if (r <= 0) continue;
+            buf[r] = 0;
+            if (parse_stat(buf, tmp)) all.push_back({pid, tmp.ppid});
+        }
+    }
+
+    // Repeat until no new descendant shows up (handles any order of pids)
+    bool added = true;
+    while (added) {
+        added = false;
+        for (auto &pp : all) {
+            if (!procs.count(pp.first) && (pp.second == root || procs.count(pp.second)))
+                added |= track(pp.first);
+        }
+    }
+}
+
+// ---------------- Sampling ----------------
+
+struct Sample {
+    int total = 0, running = 0, sleeping = 0, zombies = 0;
+    int added = 0, exited = 0, reparented = 0;
+    long long cpu_delta = 0;
+    long rss_pages = 0;
+};
+
+Sample sample(int root) {
+    Sample s;
+    int before = procs.size();
+    track(root);
+    if (have_children_files) discover_children(root);
+    else discover_scan(root);
+    s.added = procs.size() - before;
+
+    vector<int> gone;
+    for (auto &kv : procs) {
+        Proc &p = kv.second;
+        char old_state = p.state;
+        int old_ppid = p.ppid;
+        long long old_cpu = p.cpu_ticks;
+
+        if (!refresh(p)) { // process disappeared (reaped)
+            gone.push_back(kv.first);
+            continue;
+        }
+
+        if (p.ppid != old_ppid) {
+            s.reparented++;
+            cout << "  PID " << kv.first << ": parent " << old_ppid << " -> " << p.ppid << " (orphaned, re-parented)" << endl;
+        }
+        if (p.state == 'Z' && old_state != 'Z')
+            cout << "  PID " << kv.first << ": became a zombie (parent " << p.ppid << " has not waited)" << endl;
+
+        s.total++;
+        if (p.state == 'R') s.running++;
+        else if (p.state == 'Z') s.zombies++;
+        else s.sleeping++;
+        s.cpu_delta += p.cpu_ticks - old_cpu;
+        s.rss_pages += p.rss_pages;
+    }
+
+    for (int pid : gone) {
+        close(procs[pid].stat_fd);
+        if (procs[pid].children_fd >= 0) close(procs[pid].children_fd);
+        procs.erase(pid);
+    }
+    s.exited = gone.size();
+    return s;
+}
+
+// ---------------- Demo subtree ----------------
+
+// root -> N children. Every 3rd child exits at once (zombie until root waits, which it never
+// does); the rest sleep. Halfway through, root exits: its sleepers are orphaned and re-parented
+// to us (we are a child subreaper), its zombies are handed to us and reaped.
+
+int make_demo_tree(int n, int seconds) {
+    pid_t root = fork();
+    if (root == 0) {
+        for (int i = 0; i < n; i++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                if (i % 3 == 0) _exit(0);
+                sleep(seconds);
+                _exit(0);
+            }
+            if (pid < 0) break;
+        }
+        sleep(seconds / 2);
+        _exit(0); // exits without wait() -> zombies and orphans
+    }
+    return root;
+}
+
+int main(int argc, char *argv[]) {
+    int root = argc > 1 ? atoi(argv[1]) : 0;      // 0 = build a demo subtree
+    double hz = argc > 2 ? atof(argv[2]) : 10;
+    int seconds = argc > 3 ? atoi(argv[3]) : 6;
+    int demo_children = argc > 4 ? atoi(argv[4]) : 30;
+    if (hz <= 0) hz = 10;
+
+    rlimit rl; // two fds per tracked process
+    getrlimit(RLIMIT_NOFILE, &rl);
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+
+    proc_fd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (proc_fd < 0) {
+        cerr << "Cannot open /proc" << endl;
+        return 1;
+    }
+    char probe[64]; // CONFIG_PROC_CHILDREN: decide once, not on every process that exits
+    snprintf(probe, sizeof(probe), "%d/task/%d/children", getpid(), getpid());
+    have_children_files = faccessat(proc_fd, probe, F_OK, 0) == 0;
+
+    if (root == 0) {
+        prctl(PR_SET_CHILD_SUBREAPER, 1); // orphans of our subtree come to us, not to init
+        root = make_demo_tree(demo_children, seconds);
+        cout << "Demo subtree root PID: " << root << " with " << demo_children << " children" << endl;
+    }
+
+    long page_kb = sysconf(_SC_PAGESIZE) / 1024;
+    long ticks_per_sec = sysconf(_SC_CLK_TCK);
+    long long period_ns = (long long)(1e9 / hz);
+    int samples = (int)(seconds * hz) + 1;
+
+    rusage ru0;
+    getrusage(RUSAGE_SELF, &ru0);
+    long long start = now_ns();
+    long long busy_ns = 0;
+
+    cout << "\n  time   procs  run  sleep  zombie   +new  exited  reparent   tree CPU%   RSS MB" << endl;
+    for (int i = 0; i < samples; i++) {
+        long long t0 = now_ns();
+        Sample s = sample(root);
+        busy_ns += now_ns() - t0;
+
+        double cpu_pct = 100.0 * s.cpu_delta / ticks_per_sec * hz;
+        cout << fixed << setprecision(1) << setw(6) << (t0 - start) / 1e9 << "s"
+             << setw(8) << s.total << setw(5) << s.running << setw(7) << s.sleeping << setw(8) << s.zombies
+             << setw(7) << s.added << setw(8) << s.exited << setw(10) << s.reparented
+             << setw(12) << (i ? cpu_pct : 0.0) << setw(9) << s.rss_pages * page_kb / 1024.0 << endl;
+
+        while (waitpid(-1, NULL, WNOHANG) > 0) {} // reap what was re-parented to us
+
+        long long next = start + (i + 1) * period_ns;
+        long long wait_ns = next - now_ns();
+        if (wait_ns > 0) {
+            timespec ts = {wait_ns / 1000000000, wait_ns % 1000000000};
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    rusage ru1;
+    getrusage(RUSAGE_SELF, &ru1);
+    double cpu_s = (ru1.ru_utime.tv_sec - ru0.ru_utime.tv_sec) + (ru1.ru_utime.tv_usec - ru0.ru_utime.tv_usec) / 1e6 +
+                   (ru1.ru_stime.tv_sec - ru0.ru_stime.tv_sec) + (ru1.ru_stime.tv_usec - ru0.ru_stime.tv_usec) / 1e6;
+    double wall_s = (now_ns() - start) / 1e9;
+
+    cout << "\nDiscovery: " << (have_children_files ? "/proc/<pid>/task/<pid>/children" : "full /proc scan (getdents64)") << endl;
+    cout << "Sampler cost: " << busy_ns / 1e3 / samples << " us per sample, "
+         << setprecision(2) << 100.0 * cpu_s / wall_s << "% of one core" << endl;
+
+    while (waitpid(-1, NULL, 0) > 0) {}
+    return 0;
+}
+
+/*
+Compile: g++ -O2 ProcTreeSampler.cpp -o /tmp/ProcTreeSampler
+Run:     /tmp/ProcTreeSampler                           -> demo subtree, 10 Hz, 6 s
+         /tmp/ProcTreeSampler <root pid> [hz] [seconds] -> watch an existing subtree
+
+/proc/<pid>/stat fields used: 3 state, 4 ppid, 14 utime, 15 stime, 24 rss (pages)
+State letters: R running, S sleeping, D disk wait, T stopped, Z zombie
+
+PR_SET_CHILD_SUBREAPER: orphans inside our subtree are re-parented to us instead of init
+(PID 1), so the demo can watch the ppid change and reap them.
+An open /proc/<pid>/stat fd keeps pointing at that exact process: once it is reaped,
+pread() fails instead of silently reading a new process that reused the pid.
+*/
@@ -0,0 +1,255 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>     // fork(), pipe(), ftruncate()
+#include <sys/wait.h>   // waitpid()
+#include <sys/mman.h>   // mmap(), memfd_create()
+
+using namespace std;
+
+// Returning results from child processes without copying them.
+// ProcessTermination.cpp returns a result through exit(42) + WEXITSTATUS -> only 8 bits.
+// A pipe can carry anything, but every byte is copied child -> kernel -> parent.
+// Here the parent creates a shared memory area (memfd) BEFORE fork(); each child writes
+// into its own slot and publishes it with a release store; the parent reads it after an
+// acquire load. The data itself is never copied.
+
+// Per-child header, one cache line each so children never share a line
+
+struct alignas(64) Slot {
+    atomic<uint32_t> ready; // 0 = not yet, 1 = result published
+    long long partial_sum;
+    long long count;        // number of payload values written
+};
+
+struct ResultArea {
+    int fd;
+    size_t bytes;
+    Slot *slots;         // num_children headers
+    long long *payload;  // num_children * per_child values
+};
+
+// memfd = anonymous file in RAM; mapping it MAP_SHARED gives parent and children the same pages
+// (the fd could also be passed to an exec'ed program, unlike plain MAP_ANONYMOUS)
+
+ResultArea create_area(int num_children, size_t per_child) {
+    ResultArea a;
+    size_t header = num_children * sizeof(Slot);
+    header = (header + 4095) & ~(size_t)4095; // payload starts page aligned
+    a.bytes = header + num_children * per_child * sizeof(long long);
+
+    a.fd = memfd_create("child-results", MFD_CLOEXEC);
+    if (a.fd < 0 || ftruncate(a.fd, a.bytes) != 0) {
+        cerr << "memfd_create failed!" << endl;
+        exit(1);
+    }
+    char *base = (char *)mmap(NULL, a.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, a.fd, 0);
+    if (base == MAP_FAILED) {
+        cerr << "mmap failed!" << endl;
+        exit(1);
+    }
+    a.slots = (Slot *)base;
+    for (int i = 0; i < num_children; i++)
+        new (&a.slots[i]) Slot {{0}, 0, 0};
+    a.payload = (long long *)(base + header);
+    return a;
+}
+
+void destroy_area(ResultArea &a) {
+    munmap(a.slots, a.bytes);
+    close(a.fd);
+}
+
+// ---------------- Part 1: multi-process array sum ----------------
+
+// Same job as partial_sum() in Thread/sumOfArrayMultithread.cpp, but in child processes
+
+void partial_sum(const int arr[], long long start, long long end, Slot &slot) {
+    long long s = 0;
+    for (long long i = start; i < end; i++)
+        s += arr[i];
+    slot.partial_sum = s;
+    slot.ready.store(1, memory_order_release); // publish: everything above is visible first
+}
+
+long long process_sum(const int arr[], long long n, int num_children) {
+    ResultArea area = create_area(num_children, 0);
+
+    vector<pid_t> pids;
+    for (int c = 0; c < num_children; c++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            cerr << "Fork failed!" << endl;
+            exit(1);
+        }
+        if (pid == 0) {
+            partial_sum(arr, n * c / num_children, n * (c + 1) / num_children, area.slots[c]);
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+
+    for (pid_t pid : pids)
+        waitpid(pid, NULL, 0);
+
+    long long total = 0;
+    for (int c = 0; c < num_children; c++) {
+        if (area.slots[c].ready.load(memory_order_acquire) != 1) {
+            cerr << "Child " << c << " did not publish a result!" << endl;
+            continue;
+        }
+        total += area.slots[c].partial_sum;
+    }
+
+    destroy_area(area);
+    return total;
+}
+
+// ---------------- Part 2: large per-child outputs, shared memory vs pipe ----------------
+
+// Child work: out[i] = arr[i]^2 for its part (a result as big as the input)
+
+void square_part(const int arr[], long long start, long long count, long long out[]) {
+    for (long long i = 0; i < count; i++)
+        out[i] = (long long)arr[start + i] * arr[start + i];
+}
+
+double run_shared(const int arr[], int num_children, long long per_child, long long &checksum) {
+    auto t0 = chrono::steady_clock::now();
+    ResultArea area = create_area(num_children, per_child);
+
+    for (int c = 0; c < num_children; c++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            cerr << "Fork failed!" << endl;
+            exit(1);
+        }
+        if (pid == 0) {
+            long long *out = area.payload + c * per_child;
+            square_part(arr, c * per_child, per_child, out); // written in place, no copy
+            area.slots[c].count = per_child;
+            area.slots[c].ready.store(1, memory_order_release);
+            _exit(0);
+        }
+    }
+    while (wait(NULL) > 0) {}
+
+    checksum = 0;
+    for (int c = 0; c < num_children; c++) {
+        if (area.slots[c].ready.load(memory_order_acquire) != 1) continue;
+        const long long *out = area.payload + c * per_child;
+        for (long long i = 0; i < area.slots[c].count; i++)
+            checksum += out[i];
+    }
+    destroy_area(area);
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+double run_pipe(const int arr[], int num_children, long long per_child, long long &checksum) {
+    auto t0 = chrono::steady_clock::now();
+    vector<int> read_fds;
+    vector<long long> result(num_children * per_child);
+
+    for (int c = 0; c < num_children; c++) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            cerr << "pipe failed!" << endl;
+            exit(1);
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            cerr << "Fork failed!" << endl;
+            exit(1);
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            vector<long long> out(per_child);
+            square_part(arr, c * per_child, per_child, out.data());
+
+            const char *p = (const char *)out.data(); // copy #1: user -> kernel
+            size_t left = per_child * sizeof(long long);
+            while (left > 0) {
+                ssize_t w = write(fds[1], p, left);
+                if (w <= 0) _exit(1);
+                p += w;
+                left -= w;
+            }
+            _exit(0);
+        }
+        close(fds[1]);
+        read_fds.push_back(fds[0]);
+    }
+
+    // Drain the pipes one after another (copy #2: kernel -> user)
+    for (int c = 0; c < num_children; c++) {
+        char *p = (char *)(result.data() + c * per_child);
+        size_t left = per_child * sizeof(long long);
+        while (left > 0) {
+            ssize_t r = read(read_fds[c], p, left);
+            if (r <= 0) break;
+            p += r;
+            left -= r;
+        }
+        close(read_fds[c]);
+    }
+    while (wait(NULL) > 0) {}
+
+    checksum = 0;
+    for (long long v : result) checksum += v;
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char *argv[]) {
+    int num_children = argc > 1 ? atoi(argv[1]) : 4;
+    long long max_per_child = argc > 2 ? atoll(argv[2]) : 1 << 22; // values per child
+    if (num_children < 1) num_children = 1;
+
+    long long n = num_children * max_per_child;
+    vector<int> arr(n);
+    for (long long i = 0; i < n; i++)
+        arr[i] = (int)(i % 1000) + 1;
+
+    // Part 1
+    long long expected = 0;
+    for (long long i = 0; i < n; i++) expected += arr[i];
+    long long total = process_sum(arr.data(), n, num_children);
+    cout << "Sum of " << n << " values using " << num_children << " child processes = " << total
+         << (total == expected ? " (correct)" : " (WRONG)") << endl;
+    cout << "(exit(status) could only have returned 0..255 per child)\n" << endl;
+
+    // Part 2
+    cout << left << setw(16) << "Output/child" << right << setw(14) << "shared (ms)" << setw(14) << "pipe (ms)" << setw(10) << "speedup" << endl;
+    for (long long per_child = 128; per_child <= max_per_child; per_child *= 8) {
+        long long sum_shm, sum_pipe;
+        double t_shm = run_shared(arr.data(), num_children, per_child, sum_shm);
+        double t_pipe = run_pipe(arr.data(), num_children, per_child, sum_pipe);
+
+        cout << left << setw(16) << (to_string(per_child * sizeof(long long) / 1024) + " KB") << right
+             << fixed << setprecision(3)
+             << setw(14) << t_shm << setw(14) << t_pipe
+             << setprecision(2) << setw(9) << t_pipe / t_shm << "x"
+             << (sum_shm == sum_pipe ? "" : "  (checksums differ!)") << endl;
+    }
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 SharedResult.cpp -o /tmp/SharedResult
+Run:     /tmp/SharedResult [children] [max values per child]
+
+memfd_create() + ftruncate() + mmap(MAP_SHARED) -> memory shared by parent and children
+(must be created before fork(); a MAP_PRIVATE mapping would be copy-on-write instead).
+
+Publication:
+    child:  write data ...; ready.store(1, release)
+    parent: if (ready.load(acquire) == 1) read data ...
+The release/acquire pair guarantees the parent sees the data, even if it polls the flag
+while the child is still running. Here the parent also waits with waitpid(), and a child
+that crashed before publishing is detected by ready == 0.
+*/
@@ -0,0 +1,338 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <system_error>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>    // O_CLOEXEC
+#include <unistd.h>   // fork(), vfork(), pipe2()
+#include <sys/wait.h> // waitpid()
+#include <sys/mman.h> // mmap() for clone stacks
+#include <pthread.h>
+#include <spawn.h>    // posix_spawn()
+#include <sched.h>    // clone()
+
+using namespace std;
+
+extern char **environ;
+
+// How much does it cost to create a thread or a process, and how much memory do N of them take?
+// Every method creates N instances and records the latency of each creation. The instances
+// park on a pipe, so all N are alive when memory is sampled; closing the pipe releases them,
+// then they are joined / reaped.
+
+typedef chrono::steady_clock Clock;
+
+// ---------------- Helpers ----------------
+
+// Read a "Key:   1234 kB" line from a /proc file
+
+long read_kb(const char *path, const char *key) {
+    ifstream in(path);
+    string line;
+    size_t len = strlen(key);
+    while (getline(in, line)) {
+        if (line.compare(0, len, key) == 0)
+            return atol(line.c_str() + len + 1);
+    }
+    return 0;
+}
+
+long rss_kb() { return read_kb("/proc/self/status", "VmRSS"); }
+long available_kb() { return read_kb("/proc/meminfo", "MemAvailable"); }
+
+double percentile(vector<double> &v, double p) {
+    size_t idx = (size_t)(p / 100.0 * (v.size() - 1) + 0.5);
+    return v[idx];
+}
+
+// ---------------- Instances ----------------
+
+const size_t SMALL_STACK = 64 * 1024; // stack for clone()
+
+struct Method {
+    string name;
+    size_t stack; // pthread_create: stack size set with pthread_attr_setstacksize()
+};
+
+int release_pipe[2]; // instances block reading [0] until [1] is closed
+
+void park() {
+    char c;
+    while (read(release_pipe[0], &c, 1) < 0 && errno == EINTR) {
+    }
+}
+
+void *park_pthread(void *) {
+    park();
+    return NULL;
+}
+
+int park_clone(void *) {
+    park();
+    return 0;
+}
+
+// Simple fixed thread pool (same pattern as in THREAD_CHEAT_SHEET.md)
+
+class ThreadPool {
+public:
+    ThreadPool(int n) {
+        for (int i = 0; i < n; i++)
+            workers.emplace_back([this] { work(); });
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stop = true;
+        }
+        cv.notify_all();
+        for (auto &w : workers) w.join();
+    }
+
+    void submit(function<void()> task) {
+        {
+            lock_guard<mutex> lock(mtx);
+            tasks.push(move(task));
+        }
+        cv.notify_one();
+    }
+
+private:
+    void work() {
+        while (true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(mtx);
+                cv.wait(lock, [this] { return stop || !tasks.empty(); });
+                if (stop && tasks.empty()) return;
+                task = move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex mtx;
+    condition_variable cv;
+    bool stop = false;
+};
+
+ThreadPool *pool = NULL;
+
+// One live instance, to be released and waited for later
+struct Instance {
+    thread th;
+    pthread_t tid;
+    pid_t pid = -1;
+    char *stack = NULL; // clone()
+};
+
+// Create one instance. Returns 0 or an error number.
+// vfork and pool submit cannot park: they are created and waited for right away.
+
+int spawn_one(const Method &m, Instance &inst) {
+    if (m.name == "std::thread") {
+        try {
+            inst.th = thread(park);
+        } catch (const system_error &e) {
+            return e.code().value();
+        }
+    }
+    else if (m.name.compare(0, 14, "pthread_create") == 0) {
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        int rc = pthread_attr_setstacksize(&attr, m.stack); // EINVAL below PTHREAD_STACK_MIN
+        if (rc == 0) rc = pthread_create(&inst.tid, &attr, park_pthread, NULL);
+        pthread_attr_destroy(&attr);
+        if (rc != 0) return rc; // pthread functions return the error, errno is not set
+    }
+    else if (m.name == "pool submit") {
+        mutex mx;
+        condition_variable done_cv;
+        bool done = false;
+        pool->submit([&] {
+            lock_guard<mutex> lock(mx);
+            done = true;
+            done_cv.notify_one();
+        });
+        unique_lock<mutex> lock(mx);
+        done_cv.wait(lock, [&] { return done; });
+    }
+    else if (m.name == "fork") {
+        pid_t pid = fork();
+        if (pid < 0) return errno;
+        if (pid == 0) { // child: drop its copy of the write end, or the pipe never reaches EOF
+            close(release_pipe[1]);
+            park();
+            _exit(0);
+        }
+        inst.pid = pid;
+    }
+    else if (m.name == "vfork") {
+        pid_t pid = vfork(); // parent is suspended until the child exits
+        if (pid < 0) return errno;
+        if (pid == 0) _exit(0);
+        waitpid(pid, NULL, 0);
+    }
+    else if (m.name == "posix_spawn") {
+        // cat reads the release pipe as stdin and exits at EOF
+        posix_spawn_file_actions_t fa;
+        posix_spawn_file_actions_init(&fa);
+        posix_spawn_file_actions_adddup2(&fa, release_pipe[0], 0);
+        char *args[] = {(char *)"/bin/cat", NULL};
+        int rc = posix_spawn(&inst.pid, "/bin/cat", &fa, NULL, args, environ);
+        posix_spawn_file_actions_destroy(&fa);
+        if (rc != 0) return rc;
+    }
+    else if (m.name == "clone") {
+        // CLONE_VM: child shares our address space (no page-table copy), stack grows down.
+        // CLONE_FILES: it also shares our fd table, so closing the pipe releases it.
+        void *stack = mmap(NULL, SMALL_STACK, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+        if (stack == MAP_FAILED) return errno;
+        inst.stack = (char *)stack;
+        pid_t pid = clone(park_clone, inst.stack + SMALL_STACK, CLONE_VM | CLONE_FS | CLONE_FILES | SIGCHLD, NULL);
+        if (pid < 0) {
+            int err = errno;
+            munmap(inst.stack, SMALL_STACK); // the caller drops this instance without finish()
+            inst.stack = NULL;
+            return err;
+        }
+        inst.pid = pid;
+    }
+    return 0;
+}
+
+void finish(const Method &m, Instance &inst) {
+    if (inst.th.joinable()) inst.th.join();
+    if (m.name.compare(0, 14, "pthread_create") == 0) pthread_join(inst.tid, NULL);
+    if (inst.pid > 0) waitpid(inst.pid, NULL, 0);
+    if (inst.stack) munmap(inst.stack, SMALL_STACK);
+}
+
+bool parks(const Method &m) { return m.name != "vfork" && m.name != "pool submit"; }
+
+// ---------------- Benchmark ----------------
+
+void bench(const Method &m, int count) {
+    vector<double> lat;
+    lat.reserve(count);
+    vector<Instance> instances(count);
+
+    if (pipe2(release_pipe, O_CLOEXEC) != 0) { // CLOEXEC: spawned programs only get the read end as stdin
+        cerr << "pipe failed!" << endl;
+        exit(1);
+    }
+    long rss_before = rss_kb();
+    long avail_before = available_kb();
+
+    auto start = Clock::now();
+    for (int i = 0; i < count; i++) {
+        auto t0 = Clock::now();
+        int err = spawn_one(m, instances[i]);
+        if (err) {
+            cerr << m.name << ": creation failed after " << i << " instances (" << strerror(err) << ")" << endl;
+            instances.resize(i);
+            break;
+        }
+        lat.push_back(chrono::duration<double, micro>(Clock::now() - t0).count());
+    }
+
+    // All instances are alive (parked) now
+    long rss_grow = rss_kb() - rss_before;
+    long avail_drop = avail_before - available_kb();
+
+    close(release_pipe[1]);
+    for (auto &inst : instances) finish(m, inst);
+    close(release_pipe[0]);
+    double total_s = chrono::duration<double>(Clock::now() - start).count();
+    if (lat.empty()) return;
+
+    sort(lat.begin(), lat.end());
+
+    cout << left << setw(22) << m.name << right
+         << setw(8) << lat.size()
+         << fixed << setprecision(1)
+         << setw(10) << percentile(lat, 50)
+         << setw(10) << percentile(lat, 90)
+         << setw(10) << percentile(lat, 99)
+         << setw(11) << lat.back()
+         << setw(12) << (long)(lat.size() / total_s);
+    if (parks(m))
+        cout << setw(10) << rss_grow << setw(11) << avail_drop << setw(12) << (double)avail_drop / lat.size();
+    else
+        cout << setw(10) << "-" << setw(11) << "-" << setw(12) << "-";
+    cout << endl;
+}
+
+int main(int argc, char *argv[]) {
+    int max_count = argc > 1 ? atoi(argv[1]) : 10000;
+    if (max_count < 1) max_count = 1;
+    if (max_count > 100000) max_count = 100000;
+
+    pool = new ThreadPool(max(1u, thread::hardware_concurrency()));
+
+    vector<Method> methods = {{"std::thread", 0}};
+    for (size_t kb : {16, 64, 256, 1024})
+        methods.push_back({"pthread_create " + to_string(kb) + "K", kb * 1024});
+    for (const char *name : {"pool submit", "fork", "vfork", "posix_spawn", "clone"})
+        methods.push_back({name, 0});
+
+    cout << "Latency of creation (microseconds), N = 1 .. " << max_count << " instances alive at once\n" << endl;
+    cout << left << setw(22) << "Method" << right
+         << setw(8) << "N"
+         << setw(10) << "p50"
+         << setw(10) << "p90"
+         << setw(10) << "p99"
+         << setw(11) << "max"
+         << setw(12) << "ops/sec"
+         << setw(10) << "RSS+KB"
+         << setw(11) << "MemAvl-KB"
+         << setw(12) << "KB/instance"
+         << endl;
+
+    for (int count = 1; count <= max_count; count *= 10) {
+        for (auto &m : methods)
+            bench(m, count);
+        cout << endl;
+    }
+
+    delete pool;
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -pthread SpawnBenchmark.cpp -o /tmp/SpawnBenchmark
+Run:     /tmp/SpawnBenchmark [max N]     (N = 1, 10, 100, ... up to max N, at most 100000)
+
+std::thread     -> pthread with default stack (usually 8 MB of virtual memory)
+pthread_create  -> same, with a 16 KB .. 1 MB stack set through pthread_attr_setstacksize()
+pool submit     -> no creation at all: hand a task to an existing worker and wait for it
+fork            -> copies page tables of the parent (cost grows with parent size)
+vfork           -> no copy, parent is suspended until the child calls _exit()/exec()
+posix_spawn     -> fork+exec in one call (glibc uses clone(CLONE_VM|CLONE_VFORK)), runs /bin/cat
+clone           -> raw Linux call; with CLONE_VM the child shares our memory like a thread
+
+RSS+KB      -> growth of this process's resident memory with all N instances alive
+               (thread stacks count here, forked children do not)
+MemAvl-KB   -> drop of system-wide MemAvailable with all N alive (includes children, page
+               tables, kernel stacks); noisy for small N
+KB/instance -> MemAvl-KB / N
+vfork and pool submit cannot keep instances alive, so they have no memory columns.
+A thread stack only costs the pages it touches: the stack size mostly changes the virtual
+size, and how many threads fit before mmap fails.
+Large N needs enough pids: ulimit -u, /proc/sys/kernel/threads-max, pids.max of the cgroup.
+*/
@@ -0,0 +1,270 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>          // openat()
+#include <dirent.h>         // DT_DIR, DT_REG ...
+#include <sys/stat.h>       // fstatat()
+#include <sys/syscall.h>    // SYS_getdents64
+#include <sys/resource.h>
+
+using namespace std;
+
+// Native replacement for RecursiveFileLister.sh and CountFilesDirs.sh.
+// Those scripts run `find` twice (-type f, then -type d) and pipe into `wc -l`.
+// This walks the tree ONCE, in parallel:
+//   - directories are read with getdents64() into a large buffer (many entries per syscall)
+//   - children are opened with openat() relative to the parent's fd (no path re-resolution)
+//   - every thread has its own deque of directories; idle threads steal from others
+//   - the optional listing is collected in big per-thread buffers and written in blocks
+
+struct linux_dirent64 {
+    unsigned long long d_ino;
+    long long d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+// A directory waiting to be scanned. fd >= 0 if already opened relative to its parent;
+// fd = -1 when too many fds are open, then it is opened later by path.
+
+struct DirTask {
+    int fd;
+    string path;
+};
+
+// Per-thread counters, padded so threads do not share cache lines
+
+struct alignas(64) Counts {
+    long long files = 0;
+    long long dirs = 0;
+    long long others = 0; // symlinks, sockets, devices ...
+    long long bytes = 0;
+};
+
+// ---------------- Work-stealing queues ----------------
+
+struct alignas(64) WorkQueue {
+    mutex mtx;
+    deque<DirTask> tasks;
+};
+
+int num_threads;
+vector<WorkQueue> queues;
+atomic<long long> pending(0);   // directories queued or being scanned
+atomic<int> open_fds(0);
+int max_open_fds = 1024;
+
+bool list_files = false;
+mutex out_mtx;
+const size_t OUT_BUFFER = 1 << 20;
+
+void push_task(int self, DirTask task) {
+    pending.fetch_add(1, memory_order_relaxed);
+    lock_guard<mutex> lock(queues[self].mtx);
+    queues[self].tasks.push_back(move(task)); // own end: LIFO -> depth first, cache warm
+}
+
+bool pop_task(int self, DirTask &task) {
+    {
+        lock_guard<mutex> lock(queues[self].mtx);
+        if (!queues[self].tasks.empty()) {
+            task = move(queues[self].tasks.back());
+            queues[self].tasks.pop_back();
+            return true;
+        }
+    }
+    // Steal the oldest (usually biggest) directory from another thread
+    for (int i = 1; i < num_threads; i++) {
+        WorkQueue &victim = queues[(self + i) % num_threads];
+        lock_guard<mutex> lock(victim.mtx);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void flush(string &out) {
+    if (out.empty()) return;
+    lock_guard<mutex> lock(out_mtx);
+    const char *p = out.data();
+    size_t left = out.size();
+    while (left > 0) {
+        ssize_t w = write(STDOUT_FILENO, p, left);
+        if (w <= 0) break;
+        p += w;
+        left -= w;
+    }
+    out.clear();
+}
+
+// ---------------- Scanning ----------------
+
+void scan_dir(int self, DirTask &task, vector<char> &buf, Counts &c, string &out) {
+    int dfd = task.fd;
+    if (dfd < 0) {
+        dfd = open(task.path.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (dfd < 0) return;
+        open_fds.fetch_add(1, memory_order_relaxed);
+    }
+
+    while (true) {
+        long n = syscall(SYS_getdents64, dfd, buf.data(), buf.size());
+        if (n <= 0) break;
+
+        for (long off = 0; off < n;) {
+            linux_dirent64 *d = (linux_dirent64 *)(buf.data() + off);
+            off += d->d_reclen;
+
+            const char *name = d->d_name;
+            if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0))) continue;
+
+            unsigned char type = d->d_type;
+            struct stat st;
+            bool have_stat = false;
+            if (type == DT_UNKNOWN || type == DT_REG) { // need the size anyway for regular files
+                if (fstatat(dfd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) continue;
+                have_stat = true;
+                if (S_ISDIR(st.st_mode)) type = DT_DIR;
+                else if (S_ISREG(st.st_mode)) type = DT_REG;
+                else type = DT_LNK; // anything else counts as "other"
+            }
+
+            if (type == DT_DIR) {
+                c.dirs++;
+                string child = task.path + "/" + name;
+                if (list_files) {
+                    out += child;
+                    out += "/\n";
+                }
+
+                int cfd = -1;
+                if (open_fds.load(memory_order_relaxed) < max_open_fds) {
+                    cfd = openat(dfd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                    if (cfd >= 0) open_fds.fetch_add(1, memory_order_relaxed);
+                }
+                push_task(self, DirTask {cfd, move(child)});
+            }
+            else {
+                if (type == DT_REG) {
+                    c.files++;
+                    if (have_stat) c.bytes += st.st_size;
+                } else {
+                    c.others++;
+                }
+                if (list_files) {
+                    out += task.path;
+                    out += '/';
+                    out += name;
+                    out += '\n';
+                }
+            }
+            if (out.size() >= OUT_BUFFER) flush(out);
+        }
+    }
+
+    close(dfd);
+    open_fds.fetch_sub(1, memory_order_relaxed);
+}
+
+void worker(int self, Counts &c) {
+    vector<char> buf(256 * 1024); // large getdents64 buffer, reused for every directory
+    string out;
+    out.reserve(OUT_BUFFER + 4096);
+
+    while (true) {
+        DirTask task;
+        if (pop_task(self, task)) {
+            scan_dir(self, task, buf, c, out);
+            pending.fetch_sub(1, memory_order_acq_rel);
+        }
+        else if (pending.load(memory_order_acquire) == 0) {
+            break; // nothing queued anywhere and nobody is scanning -> done
+        }
+        else {
+            this_thread::yield();
+        }
+    }
+    flush(out);
+}
+
+int main(int argc, char *argv[]) {
+    num_threads = thread::hardware_concurrency();
+    string dir = ".";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-l") == 0) list_files = true;
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) num_threads = atoi(argv[++i]);
+        else dir = argv[i];
+    }
+    if (num_threads < 1) num_threads = 1;
+    while (dir.size() > 1 && dir.back() == '/') dir.pop_back();
+
+    // Allow many directory fds to stay open, keep some headroom for everything else
+    rlimit rl;
+    getrlimit(RLIMIT_NOFILE, &rl);
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+    max_open_fds = rl.rlim_cur > 256 ? (int)(rl.rlim_cur - 128) : 128;
+
+    int root = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root < 0) {
+        cerr << "Cannot open directory: " << dir << endl;
+        return 1;
+    }
+    open_fds = 1;
+
+    queues = vector<WorkQueue>(num_threads);
+    vector<Counts> counts(num_threads);
+    push_task(0, DirTask {root, dir});
+
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int t = 0; t < num_threads; t++)
+        threads.emplace_back(worker, t, ref(counts[t]));
+    for (auto &th : threads) th.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    Counts total;
+    for (auto &c : counts) {
+        total.files += c.files;
+        total.dirs += c.dirs;
+        total.others += c.others;
+        total.bytes += c.bytes;
+    }
+
+    // Summary goes to stderr so `DirWalker -l dir > list.txt` keeps the listing clean
+    cerr << "📂 Directory: " << dir << endl;
+    cerr << "🗂️ Files: " << total.files << endl;
+    cerr << "📦 Subdirectories: " << total.dirs << endl;
+    cerr << "🔗 Other entries: " << total.others << endl;
+    cerr << "💾 Total size: " << total.bytes << " bytes" << endl;
+    cerr << "⏱️ " << secs * 1000 << " ms with " << num_threads << " threads" << endl;
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -pthread DirWalker.cpp -o /tmp/DirWalker
+Run:     /tmp/DirWalker [-l] [-j threads] <dir>
+         -l  also list every entry (directories end with '/'), like RecursiveFileLister.sh
+
+Same numbers as CountFilesDirs.sh:
+    find dir -type f | wc -l          -> Files
+    find dir -type d | wc -l  (- 1)   -> Subdirectories (root not counted)
+
+getdents64 -> raw directory entries, d_type tells file / dir without a stat() call
+openat     -> open "name" relative to an already open directory fd
+Symlinks are counted but never followed (O_NOFOLLOW / AT_SYMLINK_NOFOLLOW), like find.
+*/
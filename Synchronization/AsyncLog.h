@@ -0,0 +1,297 @@
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+// Asynchronous logger: keeps terminal I/O out of critical sections.
+//
+//     mtx.lock();
+//     ALOG("Produced: %d | Buffer count: %d\n", value, count);   // ~50 ns, no system call
+//     mtx.unlock();
+//
+// `cout << ...` inside a lock makes every lock hold include a blocking write() to the
+// terminal. ALOG only copies the format pointer, a timestamp and the raw argument bytes
+// into a ring buffer owned by the calling thread (single producer, single consumer, no
+// lock, no allocation). Formatting with snprintf() happens later in a background thread,
+// which drains all rings, orders the records by timestamp and writes them with one writev().
+//
+// The ~50 ns is the median AsyncLogBench prints as "ALOG hot path"; more than half of it is
+// reading the timestamp.
+// A thread's ring is freed by the background thread once the thread has exited and the
+// ring has been drained.
+//
+// Rules for the arguments: at most 40 bytes of numbers / pointers per record, and
+// `const char *` arguments must stay valid until printed (string literals, globals).
+//
+// When a ring is full:
+//   ALOG_POLICY=block (default)  the caller waits until the background thread makes room
+//   ALOG_POLICY=drop             the record is thrown away and counted; the count is logged
+// Everything still in the rings is written when the program exits normally.
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <chrono>
+#include <queue>
+#include <type_traits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/uio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace alog {
+
+const int RING_SLOTS = 4096; // power of two
+const int ARG_BYTES = 40;    // record = 64 bytes = one cache line
+
+typedef int (*FormatFn)(const char *fmt, const void *args, char *out, size_t cap);
+
+struct Record {
+    uint64_t ts;
+    const char *fmt;
+    FormatFn format;
+    alignas(8) char args[ARG_BYTES];
+};
+
+// Cheapest monotonic clock: TSC on x86, steady_clock elsewhere
+inline uint64_t timestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+// One per logging thread. head is written only by the owner, tail only by the drainer.
+struct Ring {
+    alignas(64) std::atomic<uint64_t> head{0};
+    uint64_t cached_tail = 0; // owner's last view of tail, saves a cache miss per record
+    alignas(64) std::atomic<uint64_t> tail{0};
+    alignas(64) std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> retired{false}; // owner thread has exited, no more records will come
+    Record slots[RING_SLOTS];
+};
+
+// The arguments as one plain struct {a0, {a1, {a2, {}}}} (std::tuple is not trivially copyable)
+template <class... T> struct Pack {};
+template <class H, class... T> struct Pack<H, T...> {
+    H head;
+    Pack<T...> rest;
+};
+
+inline Pack<> pack() { return {}; }
+template <class H, class... T> Pack<H, T...> pack(H h, T... t) { return {h, pack(t...)}; }
+
+template <class... Done>
+int call_snprintf(char *out, size_t cap, const char *fmt, const Pack<> &, Done... done) {
+    return snprintf(out, cap, fmt, done...);
+}
+template <class H, class... T, class... Done>
+int call_snprintf(char *out, size_t cap, const char *fmt, const Pack<H, T...> &p, Done... done) {
+    return call_snprintf(out, cap, fmt, p.rest, done..., p.head);
+}
+
+// Typed formatter, instantiated once per argument list: unpacks the bytes and calls snprintf
+template <class P>
+int format_record(const char *fmt, const void *args, char *out, size_t cap) {
+    P p;
+    memcpy(&p, args, sizeof(p));
+    return call_snprintf(out, cap, fmt, p);
+}
+
+class Logger {
+    std::mutex m; // only for registering rings
+    std::vector<Ring *> rings;
+    std::thread drainer;
+    std::atomic<bool> stop{false};
+    std::mutex sleep_m;
+    std::condition_variable sleep_cv; // a writer with a full ring wakes the drainer early
+    struct Later {
+        bool operator()(const Record &a, const Record &b) const { return a.ts > b.ts; }
+    };
+    // Drained records, oldest on top, some waiting for slower threads to catch up (see drain)
+    std::priority_queue<Record, std::vector<Record>, Later> pending;
+    uint64_t reported_drops = 0;
+    uint64_t retired_drops = 0; // drop counts of rings already freed
+    int fd = STDOUT_FILENO;
+
+public:
+    bool block;
+
+    Logger() {
+        const char *p = getenv("ALOG_POLICY");
+        block = !(p && strcmp(p, "drop") == 0);
+        drainer = std::thread([this] { run(); });
+        atexit([] { instance().shutdown(); });
+    }
+
+    static Logger &instance() {
+        static Logger *logger = new Logger(); // never destroyed: rings may outlive main()
+        return *logger;
+    }
+
+    Ring *add_ring() {
+        Ring *r = new Ring();
+        std::lock_guard<std::mutex> lk(m);
+        rings.push_back(r);
+        return r;
+    }
+
+    void wake() { sleep_cv.notify_one(); }
+
+    void shutdown() {
+        if (stop.exchange(true)) return;
+        drainer.join();
+        drain(true);
+    }
+
+private:
+    void run() {
+        while (!stop.load(std::memory_order_acquire)) {
+            if (drain(false) == 0) {
+                std::unique_lock<std::mutex> lk(sleep_m);
+                sleep_cv.wait_for(lk, std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    // Copy every published record out of the rings, sort by timestamp, format, writev().
+    // A record is stamped a few ns before it is published, so a record from ring A can show
+    // up after a newer one from ring B was already taken. Records newer than `horizon` stay
+    // in `pending` until the next round, which keeps the output in order.
+    size_t drain(bool final) {
+        std::vector<Ring *> rs;
+        {
+            std::lock_guard<std::mutex> lk(m);
+            rs = rings;
+        }
+        uint64_t horizon = timestamp() - 1000000; // 1M TSC ticks (~0.3 ms) or 1 ms of steady_clock
+        size_t got = 0;
+        uint64_t drops = retired_drops;
+        std::vector<Ring *> done;
+        for (Ring *r : rs) {
+            bool retired = r->retired.load(std::memory_order_acquire); // before head: then head is final
+            uint64_t t = r->tail.load(std::memory_order_relaxed);
+            uint64_t h = r->head.load(std::memory_order_acquire);
+            got += h - t;
+            for (; t < h; t++) pending.push(r->slots[t & (RING_SLOTS - 1)]);
+            r->tail.store(t, std::memory_order_release);
+            drops += r->dropped.load(std::memory_order_relaxed);
+            if (retired) done.push_back(r);
+        }
+        if (!done.empty()) { // records are copied into `pending`, the rings can go
+            std::lock_guard<std::mutex> lk(m);
+            for (Ring *r : done) {
+                retired_drops += r->dropped.load(std::memory_order_relaxed);
+                for (size_t i = 0; i < rings.size(); i++)
+                    if (rings[i] == r) rings.erase(rings.begin() + i);
+                delete r;
+            }
+        }
+        write_records(final ? UINT64_MAX : horizon, drops);
+        return got;
+    }
+
+    // Format and write every pending record older than `until`
+    void write_records(uint64_t until, uint64_t drops) {
+        const size_t BLOCK = 64 * 1024;
+        std::vector<std::vector<char>> blocks;
+        std::vector<iovec> iov;
+        char line[1024];
+        auto append = [&](const char *s, size_t len) {
+            if (blocks.empty() || blocks.back().size() + len > BLOCK) {
+                blocks.emplace_back();
+                blocks.back().reserve(BLOCK);
+            }
+            blocks.back().insert(blocks.back().end(), s, s + len);
+        };
+        for (; !pending.empty() && pending.top().ts < until; pending.pop()) {
+            const Record &rec = pending.top();
+            int len = rec.format(rec.fmt, rec.args, line, sizeof(line));
+            if (len > 0) append(line, std::min<size_t>(len, sizeof(line) - 1));
+        }
+        if (drops > reported_drops) {
+            int len = snprintf(line, sizeof(line), "[alog] %llu records dropped (ring full)\n",
+                               (unsigned long long)(drops - reported_drops));
+            append(line, len);
+            reported_drops = drops;
+        }
+        for (auto &b : blocks) iov.push_back({b.data(), b.size()});
+
+        // One system call for up to IOV_MAX blocks; a short write continues where it stopped
+        size_t first = 0;
+        while (first < iov.size()) {
+            ssize_t w = writev(fd, &iov[first], std::min<size_t>(iov.size() - first, 1024));
+            if (w < 0) return;
+            while (first < iov.size() && (size_t)w >= iov[first].iov_len) w -= iov[first++].iov_len;
+            if (first < iov.size()) {
+                iov[first].iov_base = (char *)iov[first].iov_base + w;
+                iov[first].iov_len -= w;
+            }
+        }
+    }
+};
+
+// Marks the thread's ring retired when the thread exits. It has a destructor, so it needs a
+// TLS guard; it is only touched on the thread's first record, not in the hot path.
+struct RingOwner {
+    Ring *ring = NULL;
+    ~RingOwner() {
+        if (ring) ring->retired.store(true, std::memory_order_release);
+    }
+};
+
+inline Ring *my_ring() {
+    static thread_local Ring *ring = NULL; // constant-initialized: no TLS guard on every call
+    if (!ring) {
+        static thread_local RingOwner owner;
+        ring = owner.ring = Logger::instance().add_ring();
+    }
+    return ring;
+}
+
+template <class... Args>
+inline void log(const char *fmt, Args... args) {
+    typedef Pack<Args...> P;
+    static_assert(sizeof(P) <= ARG_BYTES, "ALOG: too many argument bytes for one record");
+    static_assert(std::is_trivially_copyable<P>::value, "ALOG: arguments must be plain values");
+
+    Ring *r = my_ring();
+    uint64_t h = r->head.load(std::memory_order_relaxed);
+    if (h - r->cached_tail >= RING_SLOTS) {
+        r->cached_tail = r->tail.load(std::memory_order_acquire);
+        if (h - r->cached_tail >= RING_SLOTS) Logger::instance().wake();
+        while (h - r->cached_tail >= RING_SLOTS) {
+            if (!Logger::instance().block) {
+                r->dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            sched_yield();
+            r->cached_tail = r->tail.load(std::memory_order_acquire);
+        }
+    }
+    Record &rec = r->slots[h & (RING_SLOTS - 1)];
+    rec.ts = timestamp();
+    rec.fmt = fmt;
+    rec.format = &format_record<P>;
+    P p = pack(args...);
+    memcpy(rec.args, &p, sizeof(p));
+    r->head.store(h + 1, std::memory_order_release);
+}
+
+} // namespace alog
+
+// printf-style; the dead printf() only lets the compiler check the format against the arguments
+#define ALOG(...)                        \
+    do {                                 \
+        if (false) printf(__VA_ARGS__);  \
+        alog::log(__VA_ARGS__);          \
+    } while (0)
+
+#endif
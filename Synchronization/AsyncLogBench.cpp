@@ -0,0 +1,116 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include "AsyncLog.h"
+
+using namespace std;
+
+// Logging inside a critical section: cout vs ALOG.
+// Every thread does `lock; shared++; log one line; unlock` and we time how long the lock
+// is held and how many critical sections per second all threads get through.
+// The log lines go to stdout, the results to stderr:
+//     /tmp/AsyncLogBench 4 200000 > /tmp/log.txt        (or a terminal, which is slower)
+
+typedef chrono::steady_clock Clock;
+
+mutex mtx;
+long long shared_counter = 0;
+
+double ns_since(Clock::time_point t)
+{
+    return chrono::duration<double, nano>(Clock::now() - t).count();
+}
+
+struct Result
+{
+    double seconds;
+    double hold_ns; // mean lock hold time
+};
+
+Result run(bool async, int threads, int iterations)
+{
+    vector<double> hold(threads, 0);
+    vector<thread> pool;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; t++)
+    {
+        pool.emplace_back([&, t] {
+            for (int i = 0; i < iterations; i++)
+            {
+                mtx.lock();
+                auto t0 = Clock::now();
+                shared_counter++;
+                if (async)
+                    ALOG("Thread %d: item %d, counter %lld\n", t, i, shared_counter);
+                else
+                    cout << "Thread " << t << ": item " << i << ", counter " << shared_counter << endl;
+                hold[t] += ns_since(t0);
+                mtx.unlock();
+            }
+        });
+    }
+    for (auto &th : pool)
+        th.join();
+    Result r = {ns_since(start) / 1e9, 0};
+    for (double h : hold)
+        r.hold_ns += h / ((double)threads * iterations);
+    return r;
+}
+
+// Cost of one ALOG call when its ring has room: bursts that fit in the ring, drained in
+// between. Median burst, so a burst interrupted by the drainer (or anybody else) does not count.
+double hot_path_ns()
+{
+    const int BURST = alog::RING_SLOTS / 2, ROUNDS = 51;
+    vector<double> per_record;
+    for (int r = 0; r < ROUNDS; r++)
+    {
+        auto t0 = Clock::now();
+        for (int i = 0; i < BURST; i++)
+            ALOG("hot path %d %d\n", r, i);
+        per_record.push_back(ns_since(t0) / BURST);
+        this_thread::sleep_for(chrono::milliseconds(5));
+    }
+    nth_element(per_record.begin(), per_record.begin() + ROUNDS / 2, per_record.end());
+    return per_record[ROUNDS / 2];
+}
+
+int main(int argc, char *argv[])
+{
+    int threads = argc > 1 ? atoi(argv[1]) : 4;
+    int iterations = argc > 2 ? atoi(argv[2]) : 100000;
+
+    double hot = hot_path_ns();
+    Result sync = run(false, threads, iterations);
+    Result async = run(true, threads, iterations);
+    alog::Logger::instance().shutdown(); // wait for the last records before timing is printed
+
+    long long total = (long long)threads * iterations;
+    cerr << fixed << setprecision(1);
+    cerr << threads << " threads x " << iterations << " critical sections\n";
+    cerr << "ALOG hot path: " << hot << " ns per record (median burst)\n\n";
+    cerr << "Logger   Lock hold (ns)   Sections/s    Total (s)\n";
+    cerr << "cout     " << setw(14) << sync.hold_ns << setw(13) << total / sync.seconds << setw(13)
+         << setprecision(3) << sync.seconds << endl;
+    cerr << setprecision(1) << "ALOG     " << setw(14) << async.hold_ns << setw(13) << total / async.seconds
+         << setw(13) << setprecision(3) << async.seconds << endl;
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -pthread AsyncLogBench.cpp -o /tmp/AsyncLogBench
+Run:     /tmp/AsyncLogBench [threads] [iterations] > /tmp/log.txt
+         ALOG_POLICY=drop /tmp/AsyncLogBench 4 1000000 > /tmp/log.txt   (drop instead of wait when full)
+
+With cout the lock is held for the whole formatting + write() (endl flushes every line), so
+the other threads queue behind terminal / file I/O. With ALOG the lock is held only for
+the hot path printed above (copying the record into the thread's ring, see AsyncLog.h);
+the writes happen in the background thread in 64 KB blocks, one writev() per batch.
+"Total" for ALOG does not include the final drain, it is the time the threads were busy.
+*/
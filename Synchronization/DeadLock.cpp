@@ -2,11 +2,12 @@
 #include <thread>
 #include <mutex>
 #include <unistd.h> // for sleep
+#include "VirtualTime.h" // VT_SEED / VT_SWEEP: deterministic virtual time
 
 using namespace std;
 
-mutex mtx1;
-mutex mtx2;
+vt::mutex mtx1;
+vt::mutex mtx2;
 
 void thread1_fun() {
     
@@ -15,7 +16,7 @@ void thread1_fun() {
     mtx1.lock(); // Thread 1 owns resource 1
     cout << "Thread 1: Locked mtx1" << endl;
 
-    sleep(1); // wait so that thread 2 can lock mtx2
+    vt::sleep(1); // wait so that thread 2 can lock mtx2
 
     cout << "Thread 1: Trying to lock mtx2" << endl;
     mtx2.lock();
@@ -32,7 +33,7 @@ void thread2_fun() {
     mtx2.lock(); // Thread 2 owns resource 2
     cout << "Thread 2: Locked mtx2" << endl;
 
-    sleep(1); // wait so that thread 1 can lock mtx1
+    vt::sleep(1); // wait so that thread 1 can lock mtx1
 
     cout << "Thread 2: Trying to lock mtx1" << endl;
     mtx1.lock();
@@ -46,8 +47,8 @@ void thread2_fun() {
 int main() {
     cout << "Main: Starting threads" << endl;
 
-    thread t1(thread1_fun);
-    thread t2(thread2_fun);
+    vt::thread t1(thread1_fun);
+    vt::thread t2(thread2_fun);
 
     t1.join();
     t2.join();
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <cstdlib>
+#include "Locks.h"
+
+using namespace std;
+
+// Contention benchmark for Locks.h against std::mutex.
+// Every thread loops: lock, critical section, unlock, a little private work.
+//   short: the critical section is `counter++` (like readCount++ in ReaderWriterMultiThread.cpp)
+//   long:  the critical section walks 32 cache lines of shared data (~1 us)
+// Reported per lock and thread count:
+//   Mops/s    lock/unlock pairs per microsecond, all threads together
+//   Jain      Jain's fairness index of the per-thread counts (1 = all equal, 1/n = one thread got all)
+//   Min/Max   least / most successful thread, relative to the mean
+
+struct StdMutex : mutex {
+    static constexpr const char *name = "std::mutex";
+};
+
+const int LONG_LINES = 32;
+
+struct alignas(64) Shared {
+    long long counter = 0;
+    long long lines[LONG_LINES][8] = {};
+};
+
+Shared shared_data;
+atomic<bool> stop_flag;
+
+struct alignas(64) PerThread {
+    long long ops = 0;
+};
+
+struct Result {
+    double mops;
+    double jain, min_rel, max_rel;
+};
+
+void private_work(unsigned &seed) {
+    // A few dozen ns of unshared work between acquisitions (xorshift, varies per iteration)
+    int n = 16 + (seed & 31);
+    for (int i = 0; i < n; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+    }
+}
+
+template <class Lock>
+Result run(int threads, bool long_cs, int ms) {
+    Lock lk;
+    vector<PerThread> counts(threads);
+    vector<thread> pool;
+    atomic<int> ready(0);
+    stop_flag = false;
+    shared_data.counter = 0;
+
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            unsigned seed = 2463534242u + t;
+            long long ops = 0;
+            ready++;
+            while (ready.load() < threads) this_thread::yield();
+            while (!stop_flag.load(memory_order_relaxed)) {
+                lk.lock();
+                shared_data.counter++;
+                if (long_cs)
+                    for (int i = 0; i < LONG_LINES; i++) shared_data.lines[i][0] += shared_data.counter;
+                lk.unlock();
+                ops++;
+                private_work(seed);
+            }
+            counts[t].ops = ops;
+        });
+    }
+    while (ready.load() < threads) this_thread::yield();
+    auto start = chrono::steady_clock::now();
+    this_thread::sleep_for(chrono::milliseconds(ms));
+    stop_flag = true;
+    for (auto &th : pool) th.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long total = 0, mn = LLONG_MAX, mx = 0;
+    double sq = 0;
+    for (auto &c : counts) {
+        total += c.ops;
+        sq += (double)c.ops * c.ops;
+        mn = min(mn, c.ops);
+        mx = max(mx, c.ops);
+    }
+    if (total != shared_data.counter) {
+        cerr << Lock::name << ": lost updates (" << shared_data.counter << " != " << total << ")" << endl;
+        exit(1);
+    }
+    double mean = (double)total / threads;
+    return {total / secs / 1e6, (double)total * total / (threads * sq), mn / mean, mx / mean};
+}
+
+template <class Lock>
+void row(int threads, bool long_cs, int ms) {
+    Result r = run<Lock>(threads, long_cs, ms);
+    cout << left << setw(12) << Lock::name << right << setw(8) << threads << fixed << setprecision(2) << setw(10)
+         << r.mops << setprecision(3) << setw(8) << r.jain << setprecision(2) << setw(7) << r.min_rel << setw(6)
+         << r.max_rel << endl;
+}
+
+int main(int argc, char *argv[]) {
+    int ms = argc > 1 ? atoi(argv[1]) : 100;
+    int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+
+    cout << "Hardware threads: " << thread::hardware_concurrency() << ", " << ms << " ms per run\n";
+    for (int long_cs = 0; long_cs < 2; long_cs++) {
+        cout << "\n" << (long_cs ? "Long critical section (32 cache lines)" : "Short critical section (counter++)")
+             << "\nLock         Threads    Mops/s    Jain    Min   Max\n";
+        for (int t = 1; t <= max_threads; t *= 2) {
+            row<StdMutex>(t, long_cs, ms);
+            row<TicketLock>(t, long_cs, ms);
+            row<McsLock>(t, long_cs, ms);
+            row<ClhLock>(t, long_cs, ms);
+            row<AdaptiveMutex>(t, long_cs, ms);
+        }
+    }
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -pthread LockBench.cpp -o /tmp/LockBench
+Run:     /tmp/LockBench [ms per run] [max threads]
+
+What to look for on a many-core machine:
+- ticket: fair (Jain ~1, FIFO) but throughput drops as threads grow, every release is a
+  cache miss for every spinning thread.
+- mcs / clh: also FIFO, throughput stays flat with thread count (one line moves per handoff).
+- std::mutex / adaptive: not FIFO, often the highest throughput (the releasing thread
+  re-acquires while its cache is hot), but Min/Max show that some threads get much less.
+- adaptive vs std::mutex: fewer futex sleeps for short critical sections, since it spins first.
+When threads > CPUs, the FIFO spin locks suffer: the next thread in line may be descheduled,
+and everybody behind it waits (the sched_yield() in the spin loops keeps this bounded).
+On a 1-CPU machine every FIFO lock shows this: one thread is preempted while it waits in
+line, the lock is handed to it anyway, and nobody gets the lock until it runs again
+(Jain ~1/n, Mops/s 10-100x lower than std::mutex / adaptive).
+*/
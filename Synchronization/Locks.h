@@ -0,0 +1,222 @@
+#ifndef LOCKS_H
+#define LOCKS_H
+
+// A family of mutual-exclusion locks with the same interface as std::mutex
+// (lock() / unlock(), so lock_guard and unique_lock work with all of them):
+//
+//   TicketLock     take a number, wait until it is served. FIFO, but every waiter spins on
+//                  the same `serving` line, so every release invalidates all waiters' caches.
+//   McsLock        queue of nodes; each waiter spins on its OWN node, the releaser writes
+//                  only the successor's node. FIFO, one cache miss per handoff.
+//   ClhLock        like MCS but each waiter spins on its PREDECESSOR's node; the releaser
+//                  writes only its own node. No "find the successor" race in unlock().
+//   AdaptiveMutex  futex mutex (0 free, 1 locked, 2 locked + sleepers). Spins with exponential
+//                  backoff first; how long it spins adapts to how long spinning used to take.
+//                  Not FIFO, but a waiter that parks costs no CPU.
+//
+// The spinning locks call sched_yield() after a few thousand spins: with more threads than
+// CPUs the thread that holds (or is next in line for) the lock may not be running.
+
+#include <atomic>
+#include <vector>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Exponential backoff: 1, 2, 4 ... LIMIT pauses, then yield the CPU now and then
+struct Backoff {
+    static const int LIMIT = 1024;
+    int delay = 1, spins = 0;
+
+    void pause() {
+        for (int i = 0; i < delay; i++) cpu_relax();
+        if (delay < LIMIT) delay *= 2;
+        else if (++spins % 4 == 0) sched_yield();
+    }
+};
+
+// ---------------- Ticket lock ----------------
+
+class TicketLock {
+    alignas(64) std::atomic<unsigned> next{0};
+    alignas(64) std::atomic<unsigned> serving{0};
+
+public:
+    static constexpr const char *name = "ticket";
+
+    void lock() {
+        unsigned me = next.fetch_add(1, std::memory_order_relaxed);
+        int spins = 0;
+        for (;;) {
+            unsigned s = serving.load(std::memory_order_acquire);
+            if (s == me) return;
+            // Proportional backoff: the further back in line, the longer to wait before looking again
+            for (unsigned i = 0; i < (me - s) * 64; i++) cpu_relax();
+            if (++spins % 256 == 0) sched_yield();
+        }
+    }
+
+    void unlock() { serving.store(serving.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+};
+
+// ---------------- Queue-lock nodes ----------------
+
+// A thread can wait for / hold several queue locks at once, so nodes come from a small
+// per-thread free list instead of one node per thread. Only lock() / unlock() of a
+// contended queue lock touch it.
+template <class Node>
+struct NodePool {
+    std::vector<Node *> free;
+
+    ~NodePool() {
+        for (Node *n : free) delete n;
+    }
+
+    static NodePool &mine() {
+        thread_local NodePool pool;
+        return pool;
+    }
+
+    Node *get() {
+        if (free.empty()) return new Node();
+        Node *n = free.back();
+        free.pop_back();
+        return n;
+    }
+
+    void put(Node *n) { free.push_back(n); }
+};
+
+// ---------------- MCS lock ----------------
+
+class McsLock {
+    struct alignas(64) Node {
+        std::atomic<Node *> next{NULL};
+        std::atomic<bool> locked{false};
+    };
+
+    std::atomic<Node *> tail{NULL};
+    Node *holder = NULL; // written only by the thread that holds the lock
+
+public:
+    static constexpr const char *name = "mcs";
+
+    void lock() {
+        Node *me = NodePool<Node>::mine().get();
+        me->next.store(NULL, std::memory_order_relaxed);
+        me->locked.store(true, std::memory_order_relaxed);
+        Node *prev = tail.exchange(me, std::memory_order_acq_rel);
+        if (prev) {
+            prev->next.store(me, std::memory_order_release);
+            Backoff b;
+            while (me->locked.load(std::memory_order_acquire)) b.pause();
+        }
+        holder = me;
+    }
+
+    void unlock() {
+        Node *me = holder;
+        Node *succ = me->next.load(std::memory_order_acquire);
+        if (!succ) {
+            Node *expected = me;
+            if (tail.compare_exchange_strong(expected, NULL, std::memory_order_release, std::memory_order_relaxed)) {
+                NodePool<Node>::mine().put(me);
+                return;
+            }
+            // A new waiter swapped the tail but has not linked itself yet
+            while (!(succ = me->next.load(std::memory_order_acquire))) cpu_relax();
+        }
+        succ->locked.store(false, std::memory_order_release);
+        NodePool<Node>::mine().put(me);
+    }
+};
+
+// ---------------- CLH lock ----------------
+
+class ClhLock {
+    struct alignas(64) Node {
+        std::atomic<bool> locked{false};
+    };
+
+    std::atomic<Node *> tail;
+    Node *holder = NULL, *holder_pred = NULL; // written only by the thread that holds the lock
+
+public:
+    static constexpr const char *name = "clh";
+
+    ClhLock() : tail(new Node()) {}
+    ~ClhLock() { delete tail.load(); }
+
+    void lock() {
+        Node *me = NodePool<Node>::mine().get();
+        me->locked.store(true, std::memory_order_relaxed);
+        Node *pred = tail.exchange(me, std::memory_order_acq_rel);
+        Backoff b;
+        while (pred->locked.load(std::memory_order_acquire)) b.pause();
+        holder = me;
+        holder_pred = pred;
+    }
+
+    // Our node now belongs to the successor; the predecessor's node is nobody's, keep it
+    void unlock() {
+        Node *me = holder, *pred = holder_pred;
+        me->locked.store(false, std::memory_order_release);
+        NodePool<Node>::mine().put(pred);
+    }
+};
+
+// ---------------- Adaptive spin-then-futex mutex ----------------
+
+inline long futex(std::atomic<int> *addr, int op, int val) {
+    return syscall(SYS_futex, reinterpret_cast<int *>(addr), op, val, NULL, NULL, 0);
+}
+
+class AdaptiveMutex {
+    std::atomic<int> state{0}; // 0 free, 1 locked, 2 locked and maybe sleepers
+    std::atomic<int> spin_limit{100}; // learned: ~2x the spins that used to be enough
+
+public:
+    static constexpr const char *name = "adaptive";
+    static const int MAX_SPINS = 4000;
+
+    void lock() {
+        int c = 0;
+        if (state.compare_exchange_strong(c, 1, std::memory_order_acquire)) return;
+
+        // Spin phase: retry with exponential backoff while the holder is likely to finish soon
+        int limit = spin_limit.load(std::memory_order_relaxed), spins = 0, delay = 1;
+        for (; spins < limit; spins++) {
+            for (int i = 0; i < delay; i++) cpu_relax();
+            if (delay < 64) delay *= 2;
+            c = 0;
+            if (state.load(std::memory_order_relaxed) == 0 &&
+                state.compare_exchange_strong(c, 1, std::memory_order_acquire)) {
+                int next = limit + (2 * spins - limit) / 8; // moving average of 2 x spins needed
+                spin_limit.store(next < 10 ? 10 : next > MAX_SPINS ? MAX_SPINS : next, std::memory_order_relaxed);
+                return;
+            }
+        }
+        // Spinning did not pay off: spin less next time, and sleep in the kernel now
+        spin_limit.store(limit > 10 ? limit - limit / 8 : 10, std::memory_order_relaxed);
+        c = state.exchange(2, std::memory_order_acquire);
+        while (c != 0) {
+            futex(&state, FUTEX_WAIT_PRIVATE, 2);
+            c = state.exchange(2, std::memory_order_acquire);
+        }
+    }
+
+    void unlock() {
+        if (state.exchange(0, std::memory_order_release) == 2) futex(&state, FUTEX_WAKE_PRIVATE, 1);
+    }
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef PI_MUTEX_H
+#define PI_MUTEX_H
+
+// pthread mutex with a priority protocol, plus blocking-time statistics per thread priority.
+//
+//     PiMutex bus;                          // PTHREAD_PRIO_INHERIT
+//     PiMutex plain(PTHREAD_PRIO_NONE);     // ordinary mutex, for comparison
+//     PiMutex ceil(PTHREAD_PRIO_PROTECT, 30) // priority ceiling 30
+//     lock_guard<PiMutex> g(bus);
+//
+// PTHREAD_PRIO_INHERIT: while a thread holds the mutex the kernel (rt_mutex / PI futex)
+// runs it at the highest priority of the threads blocked on it, so a medium-priority
+// thread cannot keep a high-priority waiter waiting.
+// Priorities only matter for SCHED_FIFO / SCHED_RR threads; under SCHED_OTHER (CFS) all
+// threads have priority 0 and the protocols change nothing.
+//
+// lock() first tries pthread_mutex_trylock(); only when that fails it reads the clock and
+// records the wait, so an uncontended lock costs the same as a plain pthread mutex.
+
+#include <pthread.h>
+#include <sched.h>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+struct BlockStats {
+    long long contended = 0; // lock() calls that had to wait
+    long long total_ns = 0, max_ns = 0;
+};
+
+class PiMutex {
+    pthread_mutex_t m;
+    std::mutex stats_lock;
+    BlockStats stats[100]; // index = SCHED_FIFO/RR priority of the caller (0 = SCHED_OTHER)
+
+    static long long now_ns() {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    }
+
+    static int my_priority() {
+        int policy;
+        sched_param sp;
+        pthread_getschedparam(pthread_self(), &policy, &sp);
+        return sp.sched_priority;
+    }
+
+public:
+    explicit PiMutex(int protocol = PTHREAD_PRIO_INHERIT, int ceiling = 0) {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        int err = pthread_mutexattr_setprotocol(&attr, protocol);
+        if (!err && protocol == PTHREAD_PRIO_PROTECT) err = pthread_mutexattr_setprioceiling(&attr, ceiling);
+        if (!err) err = pthread_mutex_init(&m, &attr);
+        pthread_mutexattr_destroy(&attr);
+        if (err) {
+            fprintf(stderr, "PiMutex: pthread_mutex_init failed: %s\n", strerror(err));
+            exit(1);
+        }
+    }
+
+    ~PiMutex() { pthread_mutex_destroy(&m); }
+
+    PiMutex(const PiMutex &) = delete;
+    PiMutex &operator=(const PiMutex &) = delete;
+
+    void lock() {
+        if (pthread_mutex_trylock(&m) == 0) return;
+        long long t0 = now_ns();
+        int err = pthread_mutex_lock(&m);
+        if (err) {
+            fprintf(stderr, "PiMutex: pthread_mutex_lock failed: %s\n", strerror(err));
+            exit(1);
+        }
+        record(my_priority(), now_ns() - t0);
+    }
+
+    bool try_lock() { return pthread_mutex_trylock(&m) == 0; }
+
+    void unlock() { pthread_mutex_unlock(&m); }
+
+    BlockStats stats_for(int prio) {
+        std::lock_guard<std::mutex> g(stats_lock);
+        return stats[prio];
+    }
+
+private:
+    void record(int prio, long long blocked_ns) {
+        std::lock_guard<std::mutex> g(stats_lock);
+        BlockStats &s = stats[prio];
+        s.contended++;
+        s.total_ns += blocked_ns;
+        if (blocked_ns > s.max_ns) s.max_ns = blocked_ns;
+    }
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <iomanip>
+#include <pthread.h>
+#include <sched.h>
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include "PiMutex.h"
+
+using namespace std;
+
+// Priority inversion with real threads (the simulation is CPU_Scheduling/PriorityInversion.cpp).
+// All threads run SCHED_FIFO on CPU 0:
+//   L (prio 10) locks the mutex and works for L_MS inside it
+//   H (prio 30) arrives, wants the mutex, blocks
+//   M (prio 20) arrives and works for M_MS without touching the mutex
+// With PTHREAD_PRIO_NONE, M preempts L, so H waits for L_MS + M_MS.
+// With PTHREAD_PRIO_INHERIT, L runs at prio 30 until it unlocks, so H waits for ~L_MS.
+// With PTHREAD_PRIO_PROTECT (ceiling 30), L runs at prio 30 from the moment it locks.
+// Needs root (or CAP_SYS_NICE) for SCHED_FIFO.
+
+const int L_PRIO = 10, M_PRIO = 20, H_PRIO = 30, MAIN_PRIO = 40;
+const int L_MS = 5, M_MS = 40, ROUNDS = 10;
+
+PiMutex *shared_mutex;
+
+// Burn CPU for ms milliseconds of this thread's own CPU time (time preempted does not count)
+void work(int ms) {
+    timespec start, now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    do {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000.0 + (now.tv_nsec - start.tv_nsec) / 1e6 < ms);
+}
+
+void sleep_ms(int ms) {
+    timespec ts = {0, ms * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+void *low(void *) {
+    shared_mutex->lock();
+    work(L_MS);
+    shared_mutex->unlock();
+    return NULL;
+}
+
+void *medium(void *) {
+    work(M_MS);
+    return NULL;
+}
+
+void *high(void *) {
+    shared_mutex->lock();
+    shared_mutex->unlock();
+    return NULL;
+}
+
+pthread_t start_fifo(void *(*fn)(void *), int prio) {
+    pthread_attr_t attr;
+    sched_param sp;
+    sp.sched_priority = prio;
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    pthread_attr_setschedparam(&attr, &sp);
+    pthread_t t;
+    int err = pthread_create(&t, &attr, fn, NULL);
+    pthread_attr_destroy(&attr);
+    if (err) {
+        cerr << "pthread_create (SCHED_FIFO) failed: " << strerror(err) << endl;
+        exit(1);
+    }
+    return t;
+}
+
+BlockStats run(int protocol) {
+    PiMutex m(protocol, H_PRIO); // the ceiling only matters for PTHREAD_PRIO_PROTECT
+    shared_mutex = &m;
+    for (int r = 0; r < ROUNDS; r++) {
+        pthread_t l = start_fifo(low, L_PRIO);
+        sleep_ms(1); // L runs and takes the mutex
+        pthread_t h = start_fifo(high, H_PRIO);
+        pthread_t mid = start_fifo(medium, M_PRIO);
+        pthread_join(h, NULL);
+        pthread_join(mid, NULL);
+        pthread_join(l, NULL);
+        sleep_ms(M_MS); // idle time, or RT throttling (sched_rt_runtime_us, 95%) stalls a round
+    }
+    return m.stats_for(H_PRIO);
+}
+
+int main() {
+    // One CPU, so that M really competes with L
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(0, &cpus);
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+        cerr << "sched_setaffinity failed!" << endl;
+        exit(1);
+    }
+    sched_param sp;
+    sp.sched_priority = MAIN_PRIO;
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+    if (err) {
+        cerr << "SCHED_FIFO not allowed (" << strerror(err) << "), run as root or with CAP_SYS_NICE" << endl;
+        exit(1);
+    }
+
+    cout << "L holds the mutex for " << L_MS << " ms, M runs " << M_MS << " ms, " << ROUNDS << " rounds\n";
+    cout << "Protocol                H blocked avg (ms)   max (ms)\n";
+    int protocols[] = {PTHREAD_PRIO_NONE, PTHREAD_PRIO_INHERIT, PTHREAD_PRIO_PROTECT};
+    const char *names[] = {"PTHREAD_PRIO_NONE", "PTHREAD_PRIO_INHERIT", "PTHREAD_PRIO_PROTECT"};
+    for (int i = 0; i < 3; i++) {
+        BlockStats s = run(protocols[i]);
+        cout << left << setw(24) << names[i] << right << fixed << setprecision(2) << setw(18)
+             << (s.contended ? s.total_ns / 1e6 / s.contended : 0.0) << setw(11) << s.max_ns / 1e6 << endl;
+    }
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -pthread PiMutexDemo.cpp -o /tmp/PiMutexDemo
+Run:     sudo /tmp/PiMutexDemo
+
+H's worst-case blocking is the number to bound for tail latency:
+  PRIO_NONE     L_MS + M_MS (+ every other medium-priority thread that shows up)
+  PRIO_INHERIT  L_MS: only the critical section itself
+  PRIO_PROTECT  L_MS as well, without waiting for H to show up first
+The kernel does the inheritance in its PI futex code (FUTEX_LOCK_PI), it also works when
+the holder itself waits for another PI mutex (chains are boosted transitively).
+*/
@@ -2,6 +2,9 @@
 #include <thread>
 #include <mutex>
 #include <unistd.h> // for sleep()
+#include "../Thread/PerfRegion.h"
+#include "AsyncLog.h"    // ALOG: logging without I/O inside the lock
+#include "VirtualTime.h" // VT_SEED / VT_SWEEP: deterministic virtual time
 
 using namespace std;
 
@@ -13,7 +16,7 @@ int in = 0;              // index where producer will put next item
 int out = 0;             // index where consumer will take next item
 int count = 0;           // current number of items in buffer
 
-mutex mtx;
+vt::mutex mtx;
 
 void producer()
 {
@@ -21,23 +24,26 @@ void producer()
     while (item < TOTAL_ITEMS)
     {
         mtx.lock();
-        if (count < BUFFER_SIZE)
         {
-            int value = rand() % 100;
-            buffer[in] = value;
-            in = (in + 1) % BUFFER_SIZE;
-            count++;
-            item++;
-            cout << "Produced: " << value << " | Buffer count: " << count << endl;
-        }
+            PerfRegion region("producer"); // the locked section
+            if (count < BUFFER_SIZE)
+            {
+                int value = rand() % 100;
+                buffer[in] = value;
+                in = (in + 1) % BUFFER_SIZE;
+                count++;
+                item++;
+                ALOG("Produced: %d | Buffer count: %d\n", value, count);
+            }
         
-        else
-        {
-            cout << "⚠️ Buffer full! Producer waiting...\n";
+            else
+            {
+                ALOG("⚠️ Buffer full! Producer waiting...\n");
+            }
         }
 
         mtx.unlock();
-        sleep(1);
+        vt::sleep(1);
     }
 }
 
@@ -47,34 +53,37 @@ void consumer()
     while (consumed < TOTAL_ITEMS)
     {
         mtx.lock();
-        if (count > 0)
         {
-            int value = buffer[out];
-            out = (out + 1) % BUFFER_SIZE;
-            count--;
-            consumed++;
-            cout << "Consumed: " << value << " | Buffer count: " << count << endl;
-        }
+            PerfRegion region("consumer"); // the locked section
+            if (count > 0)
+            {
+                int value = buffer[out];
+                out = (out + 1) % BUFFER_SIZE;
+                count--;
+                consumed++;
+                ALOG("Consumed: %d | Buffer count: %d\n", value, count);
+            }
         
-        else
-        {
-            cout << "Buffer empty! Consumer waiting...\n";
+            else
+            {
+                ALOG("Buffer empty! Consumer waiting...\n");
+            }
         }
         mtx.unlock();
-        sleep(2);
+        vt::sleep(2);
     }
 }
 
 int main()
 {
-    srand(time(NULL));
+    srand(vt::random_seed(time(NULL)));
 
-    thread t1(producer);
-    thread t2(consumer);
+    vt::thread t1(producer);
+    vt::thread t2(consumer);
 
     t1.join();
     t2.join();
 
-    cout << "Finished! All " << TOTAL_ITEMS << " items produced and consumed.\n";
+    ALOG("Finished! All %d items produced and consumed.\n", TOTAL_ITEMS);
     return 0;
 }
\ No newline at end of file
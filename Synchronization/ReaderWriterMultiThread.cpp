@@ -2,14 +2,16 @@
 #include <thread>
 #include <mutex>
 #include <unistd.h> // for sleep()
+#include "AsyncLog.h"    // ALOG: logging without I/O inside the lock
+#include "VirtualTime.h" // VT_SEED / VT_SWEEP: deterministic virtual time
 
 using namespace std;
 
 int datas = 0;      // shared data
 int readCount = 0; // number of active readers
 
-mutex mtx;        // protects readCount
-mutex writeMutex; // ensures exclusive access for writer
+vt::mutex mtx;        // protects readCount
+vt::mutex writeMutex; // ensures exclusive access for writer
 
 void reader(int id)
 {
@@ -22,8 +24,8 @@ void reader(int id)
         mtx.unlock();
 
         // Reading (critical section)
-        cout << "👁️ Reader " << id << " reads data = " << datas << endl;
-        sleep(1);
+        ALOG("👁️ Reader %d reads data = %d\n", id, datas);
+        vt::sleep(1);
 
         mtx.lock();
         readCount--;
@@ -31,7 +33,7 @@ void reader(int id)
             writeMutex.unlock(); // last reader unlocks writer
         mtx.unlock();
 
-        sleep(1); // simulate time between reads
+        vt::sleep(1); // simulate time between reads
     }
 }
 
@@ -41,25 +43,25 @@ void writer(int id)
     {                      // write 3 times
         writeMutex.lock(); // exclusive access
         datas = rand() % 100;
-        cout << "✏️ Writer " << id << " writes data = " << datas << endl;
-        sleep(2);
+        ALOG("✏️ Writer %d writes data = %d\n", id, datas);
+        vt::sleep(2);
         writeMutex.unlock();
-        sleep(1); // simulate time between writes
+        vt::sleep(1); // simulate time between writes
     }
 }
 
 int main()
 {
-    srand(time(NULL));
+    srand(vt::random_seed(time(NULL)));
 
-    thread r1(reader, 1);
-    thread r2(reader, 2);
-    thread w1(writer, 1);
+    vt::thread r1(reader, 1);
+    vt::thread r2(reader, 2);
+    vt::thread w1(writer, 1);
 
     r1.join();
     r2.join();
     w1.join();
 
-    cout << "\nFinished Reading and Writing.\n";
+    ALOG("\nFinished Reading and Writing.\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,408 @@
+#ifndef VIRTUAL_TIME_H
+#define VIRTUAL_TIME_H
+
+// Deterministic virtual-time mode for the thread demos.
+//
+// The demos model work with sleep(1) / sleep(2), so one run takes 10-30 s and the
+// interleaving is different every time. With this header they use vt::sleep, vt::mutex,
+// vt::semaphore and vt::thread instead:
+//
+//   ./demo                      real mode: plain sleep(), std::mutex, sem_t, std::thread
+//   VT_SEED=7 ./demo            virtual mode: finishes in milliseconds, same output for seed 7
+//   VT_SWEEP=1000 ./demo        runs seeds 1..1000 (one fork each) and prints statistics
+//
+// Virtual mode: the threads are real, but only ONE of them runs at a time. Every sleep,
+// lock, unlock, sem_wait, sem_post, thread start / join / exit is a scheduling point where
+// a seeded random generator picks the next runnable thread. sleep(s) does not wait, it
+// moves the thread's wake-up time s seconds into the virtual future; when nobody can run,
+// the clock jumps to the next wake-up. When nobody can run and nobody sleeps, every thread
+// waits for another one: a deadlock. It is reported (who waits for what) and the program exits.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <unistd.h>
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/wait.h>
+
+namespace vt {
+
+struct VThread {
+    int id;
+    enum State { RUNNABLE, SLEEPING, BLOCKED, FINISHED } state = RUNNABLE;
+    double wake = 0;             // SLEEPING: virtual time to wake up
+    const void *waiting_on = 0;  // BLOCKED: mutex / semaphore / thread
+    const char *waiting_what = "";
+    int holder = -1;             // BLOCKED: thread owning the mutex / thread joined
+    std::condition_variable cv;
+
+    long long acquisitions = 0;  // locks + sem_waits that succeeded
+    double wait_time = 0;        // virtual seconds spent waiting for them
+};
+
+// Per-run summary that a VT_SWEEP child sends back to the parent
+struct RunStats {
+    double makespan;
+    int deadlock;
+    int threads;
+    long long acquisitions[16];
+    double wait_time[16];
+};
+
+struct Scheduler {
+    bool enabled = false;
+    unsigned seed = 0;
+    std::mt19937_64 rng;
+    std::mutex m;
+    std::vector<VThread *> threads;
+    int current = 0;
+    double now = 0;
+    long long switches = 0;
+    int stats_fd = -1;  // pipe to the VT_SWEEP parent
+
+    Scheduler() {
+        const char *sweep = getenv("VT_SWEEP");
+        const char *s = getenv("VT_SEED");
+        if (sweep) run_sweep(atoi(sweep)); // returns only in the children
+        else if (s) start(atoi(s));
+    }
+
+    void start(unsigned sd) {
+        enabled = true;
+        seed = sd;
+        rng.seed(sd);
+        threads.push_back(new VThread()); // main thread = id 0, runs first
+        threads[0]->id = 0;
+        atexit([] { instance().at_exit(false); });
+    }
+
+    static Scheduler &instance();
+
+    // Pick who runs next (lock held). Jumps the clock forward if everybody sleeps.
+    int pick() {
+        std::vector<int> ready;
+        for (auto *t : threads)
+            if (t->state == VThread::RUNNABLE) ready.push_back(t->id);
+        if (ready.empty()) {
+            double next = INFINITY;
+            for (auto *t : threads)
+                if (t->state == VThread::SLEEPING) next = std::min(next, t->wake);
+            if (next == INFINITY) deadlock();
+            now = next;
+            for (auto *t : threads)
+                if (t->state == VThread::SLEEPING && t->wake <= now) {
+                    t->state = VThread::RUNNABLE;
+                    ready.push_back(t->id);
+                }
+        }
+        return ready[rng() % ready.size()];
+    }
+
+    // Hand the CPU to the next thread and wait until we are picked again
+    void reschedule(std::unique_lock<std::mutex> &lk, VThread *self) {
+        int next = pick();
+        switches++;
+        current = next;
+        if (next == self->id) return;
+        threads[next]->cv.notify_one();
+        if (self->state == VThread::FINISHED) return; // an exiting thread never runs again
+        while (current != self->id) self->cv.wait(lk);
+    }
+
+    void wake_all(const void *obj) {
+        for (auto *t : threads)
+            if (t->state == VThread::BLOCKED && t->waiting_on == obj) t->state = VThread::RUNNABLE;
+    }
+
+    void deadlock() {
+        std::cout << std::flush;
+        fprintf(stderr, "\n[vt] DEADLOCK at t=%gs (seed %u): no thread can run\n", now, seed);
+        for (auto *t : threads)
+            if (t->state != VThread::BLOCKED) continue;
+            else if (t->holder >= 0)
+                fprintf(stderr, "[vt]   %s waits for %s %s\n", name(t->id).c_str(), t->waiting_what, name(t->holder).c_str());
+            else
+                fprintf(stderr, "[vt]   %s waits for %s\n", name(t->id).c_str(), t->waiting_what);
+        at_exit(true);
+        _exit(2);
+    }
+
+    static std::string name(int id) { return id == 0 ? "main" : "T" + std::to_string(id); }
+
+    void at_exit(bool deadlocked) {
+        if (!enabled) return;
+        if (stats_fd >= 0) {
+            RunStats rs = {};
+            rs.makespan = now;
+            rs.deadlock = deadlocked;
+            rs.threads = std::min<int>(threads.size(), 16);
+            for (int i = 0; i < rs.threads; i++) {
+                rs.acquisitions[i] = threads[i]->acquisitions;
+                rs.wait_time[i] = threads[i]->wait_time;
+            }
+            if (write(stats_fd, &rs, sizeof(rs)) != (ssize_t)sizeof(rs)) _exit(3);
+            return;
+        }
+        std::cout << std::flush;
+        fprintf(stderr, "[vt] seed %u: virtual time %gs, %lld scheduling decisions\n", seed, now, switches);
+    }
+
+    // VT_SWEEP=N: run the program once per seed in a child, aggregate, never reach main()
+    void run_sweep(int n) {
+        std::vector<RunStats> runs;
+        for (int sd = 1; sd <= n; sd++) {
+            int fds[2];
+            if (pipe(fds) != 0) exit(1);
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(fds[0]);
+                int null = open("/dev/null", O_WRONLY);
+                dup2(null, STDOUT_FILENO);
+                dup2(null, STDERR_FILENO);
+                stats_fd = fds[1];
+                start(sd);
+                return; // child continues into main()
+            }
+            close(fds[1]);
+            RunStats rs;
+            if (read(fds[0], &rs, sizeof(rs)) == (ssize_t)sizeof(rs)) runs.push_back(rs);
+            close(fds[0]);
+            waitpid(pid, NULL, 0);
+        }
+        print_sweep(runs, n);
+        fflush(stdout);
+        _exit(0);
+    }
+
+    static void print_sweep(const std::vector<RunStats> &runs, int n) {
+        if (runs.empty()) {
+            fprintf(stderr, "[vt] no run reported statistics\n");
+            return;
+        }
+        int deadlocks = 0, threads = 0;
+        double mk_sum = 0, mk_min = INFINITY, mk_max = 0;
+        std::vector<double> acq(16, 0), wait(16, 0);
+        for (auto &r : runs) {
+            deadlocks += r.deadlock;
+            mk_sum += r.makespan;
+            mk_min = std::min(mk_min, r.makespan);
+            mk_max = std::max(mk_max, r.makespan);
+            threads = std::max(threads, r.threads);
+            for (int i = 0; i < r.threads; i++) {
+                acq[i] += r.acquisitions[i];
+                wait[i] += r.wait_time[i];
+            }
+        }
+        size_t k = runs.size();
+        printf("Seeds: %d, finished runs: %zu, deadlocks: %d (%.1f%%)\n", n, k, deadlocks, 100.0 * deadlocks / k);
+        printf("Virtual run time: mean %.2fs, min %.2fs, max %.2fs\n", mk_sum / k, mk_min, mk_max);
+
+        // Fairness: Jain's index over the mean lock/semaphore wait of the worker threads
+        // (1 = everybody waits equally, 1/n = one thread does all the waiting)
+        double total_acq = 0, s = 0, s2 = 0;
+        int m = 0;
+        printf("Thread  acquisitions/run  wait/run (s)  wait/acquisition (s)\n");
+        for (int i = 0; i < threads; i++) {
+            double a = acq[i] / k, w = wait[i] / k;
+            total_acq += a;
+            printf("%-6s  %16.2f  %12.3f  %20.3f\n", name(i).c_str(), a, w, a > 0 ? w / a : 0.0);
+            if (i > 0 && a > 0) {
+                s += w / a;
+                s2 += (w / a) * (w / a);
+                m++;
+            }
+        }
+        printf("Throughput: %.3f acquisitions per virtual second\n", total_acq / (mk_sum / k));
+        if (m > 0 && s2 > 0) printf("Jain fairness of wait per acquisition: %.3f\n", s * s / (m * s2));
+    }
+};
+
+inline Scheduler &Scheduler::instance() {
+    static Scheduler *sched = new Scheduler(); // never destroyed: still used by the atexit handler
+    return *sched;
+}
+
+// Made at program start (before main), so VT_SWEEP can fork before any thread exists
+static struct Init { Init() { Scheduler::instance(); } } vt_init;
+
+inline VThread *&self() {
+    thread_local VThread *me = 0;
+    return me;
+}
+
+inline VThread *me(Scheduler &s) {
+    return self() ? self() : s.threads[0]; // threads not made by vt::thread count as main
+}
+
+// srand() argument: the run's seed in virtual mode, so rand() repeats too
+inline unsigned random_seed(unsigned real) {
+    Scheduler &s = Scheduler::instance();
+    return s.enabled ? s.seed : real;
+}
+
+// A scheduling point without blocking
+inline void yield() {
+    Scheduler &s = Scheduler::instance();
+    if (!s.enabled) return;
+    std::unique_lock<std::mutex> lk(s.m);
+    s.reschedule(lk, me(s));
+}
+
+inline void sleep(unsigned seconds) {
+    Scheduler &s = Scheduler::instance();
+    if (!s.enabled) {
+        ::sleep(seconds);
+        return;
+    }
+    std::unique_lock<std::mutex> lk(s.m);
+    VThread *t = me(s);
+    t->state = VThread::SLEEPING;
+    t->wake = s.now + seconds;
+    s.reschedule(lk, t);
+}
+
+class mutex {
+    std::mutex real;
+    int owner = -1;
+
+public:
+    void lock() {
+        Scheduler &s = Scheduler::instance();
+        if (!s.enabled) {
+            real.lock();
+            return;
+        }
+        std::unique_lock<std::mutex> lk(s.m);
+        VThread *t = me(s);
+        double asked = s.now;
+        s.reschedule(lk, t); // another thread may grab it first
+        while (owner != -1) {
+            t->state = VThread::BLOCKED;
+            t->waiting_on = this;
+            t->waiting_what = "the mutex held by";
+            t->holder = owner;
+            s.reschedule(lk, t);
+        }
+        owner = t->id;
+        t->acquisitions++;
+        t->wait_time += s.now - asked;
+    }
+
+    void unlock() {
+        Scheduler &s = Scheduler::instance();
+        if (!s.enabled) {
+            real.unlock();
+            return;
+        }
+        std::unique_lock<std::mutex> lk(s.m);
+        owner = -1;
+        s.wake_all(this);
+        s.reschedule(lk, me(s));
+    }
+};
+
+struct semaphore {
+    sem_t real;
+    int value = 0;
+};
+
+inline int sem_init(semaphore *sem, int pshared, unsigned value) {
+    sem->value = value;
+    return Scheduler::instance().enabled ? 0 : ::sem_init(&sem->real, pshared, value);
+}
+
+inline int sem_destroy(semaphore *sem) {
+    return Scheduler::instance().enabled ? 0 : ::sem_destroy(&sem->real);
+}
+
+inline int sem_wait(semaphore *sem) {
+    Scheduler &s = Scheduler::instance();
+    if (!s.enabled) return ::sem_wait(&sem->real);
+    std::unique_lock<std::mutex> lk(s.m);
+    VThread *t = me(s);
+    double asked = s.now;
+    s.reschedule(lk, t);
+    while (sem->value == 0) {
+        t->state = VThread::BLOCKED;
+        t->waiting_on = sem;
+        t->waiting_what = "the semaphore";
+        t->holder = -1;
+        s.reschedule(lk, t);
+    }
+    sem->value--;
+    t->acquisitions++;
+    t->wait_time += s.now - asked;
+    return 0;
+}
+
+inline int sem_post(semaphore *sem) {
+    Scheduler &s = Scheduler::instance();
+    if (!s.enabled) return ::sem_post(&sem->real);
+    std::unique_lock<std::mutex> lk(s.m);
+    sem->value++;
+    s.wake_all(sem);
+    s.reschedule(lk, me(s));
+    return 0;
+}
+
+class thread {
+    std::thread real;
+    VThread *vt = 0;
+
+public:
+    template <class F, class... Args>
+    explicit thread(F &&f, Args &&...args) {
+        Scheduler &s = Scheduler::instance();
+        if (!s.enabled) {
+            real = std::thread(std::forward<F>(f), std::forward<Args>(args)...);
+            return;
+        }
+        std::unique_lock<std::mutex> lk(s.m);
+        vt = new VThread();
+        vt->id = s.threads.size();
+        s.threads.push_back(vt);
+        VThread *mine = vt;
+        real = std::thread([mine](typename std::decay<F>::type fn, typename std::decay<Args>::type... a) {
+            Scheduler &sc = Scheduler::instance();
+            self() = mine;
+            {
+                std::unique_lock<std::mutex> l(sc.m);
+                while (sc.current != mine->id) mine->cv.wait(l); // wait for our first turn
+            }
+            fn(a...);
+            std::unique_lock<std::mutex> l(sc.m);
+            mine->state = VThread::FINISHED;
+            sc.wake_all(mine);
+            sc.reschedule(l, mine);
+        }, std::forward<F>(f), std::forward<Args>(args)...);
+        s.reschedule(lk, me(s)); // the new thread may run first
+    }
+
+    void join() {
+        Scheduler &s = Scheduler::instance();
+        if (s.enabled) {
+            std::unique_lock<std::mutex> lk(s.m);
+            VThread *t = me(s);
+            while (vt->state != VThread::FINISHED) {
+                t->state = VThread::BLOCKED;
+                t->waiting_on = vt;
+                t->waiting_what = "thread";
+                t->holder = vt->id;
+                s.reschedule(lk, t);
+            }
+        }
+        real.join();
+    }
+};
+
+} // namespace vt
+
+#endif
@@ -2,11 +2,12 @@
 #include <semaphore.h>
 #include <cstdio>
 #include <unistd.h>
+#include "VirtualTime.h" // VT_SEED / VT_SWEEP: deterministic virtual time
 
 using namespace std;
 
 int shared = 4;
-sem_t s;
+vt::semaphore s;
 
 void thread_fun_1()
 {
@@ -14,7 +15,7 @@ void thread_fun_1()
     printf("Thread 1: Entering critical section\n");
     
     int temp = shared;
-    sleep(1); // Simulate some work in the critical section
+    vt::sleep(1); // Simulate some work in the critical section
     
     shared = temp + 1;
     printf("Thread 1: Exiting critical section, shared = %d\n", shared);
@@ -27,7 +28,7 @@ void thread_fun_2()
     printf("Thread 2: Entering critical section\n");
     
     int temp = shared;
-    sleep(1); // Simulate some work in the critical section
+    vt::sleep(1); // Simulate some work in the critical section
     
     shared = temp + 2;
     printf("Thread 2: Exiting critical section, shared = %d\n", shared);
@@ -38,8 +39,8 @@ int main()
 {
     sem_init(&s, 0, 1); // Initialize semaphore with value 1
     
-    thread thread1(thread_fun_1);
-    thread thread2(thread_fun_2);
+    vt::thread thread1(thread_fun_1);
+    vt::thread thread2(thread_fun_2);
     
     thread1.join();
     thread2.join();
@@ -0,0 +1,331 @@
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace std;
+
+// Lock-free bounded LIFO stack (Treiber stack) for the buffer in ProducerConsumer.cpp.
+// ProducerConsumer.cpp does buffer[buffer_count++] / buffer[--buffer_count] from two
+// threads with no protection -> race. Here both ends are a single CAS on the head.
+
+// ---------------- Treiber stack ----------------
+
+// All nodes live in one preallocated array, so "pointers" are 32-bit indexes.
+// Head = (tag << 32) | index. The tag is bumped on every successful CAS, so if a node is
+// popped and pushed back between our read and our CAS (ABA), the tag differs and the CAS fails.
+
+const uint32_t NIL = 0xFFFFFFFFu;
+
+struct Node {
+    int value;
+    atomic<uint32_t> next;
+};
+
+class IndexStack {
+public:
+    IndexStack() : head(pack(NIL, 0)) {}
+
+    void push(Node nodes[], uint32_t idx) {
+        uint64_t old = head.load(memory_order_relaxed);
+        do {
+            nodes[idx].next.store(index_of(old), memory_order_relaxed);
+        } while (!head.compare_exchange_weak(old, pack(idx, tag_of(old) + 1), memory_order_release, memory_order_relaxed));
+    }
+
+    // One attempt only: returns false if another thread won the race (used for elimination)
+    bool try_push(Node nodes[], uint32_t idx) {
+        uint64_t old = head.load(memory_order_relaxed);
+        nodes[idx].next.store(index_of(old), memory_order_relaxed);
+        return head.compare_exchange_strong(old, pack(idx, tag_of(old) + 1), memory_order_release, memory_order_relaxed);
+    }
+
+    uint32_t pop(Node nodes[]) {
+        uint64_t old = head.load(memory_order_acquire);
+        while (index_of(old) != NIL) {
+            uint32_t next = nodes[index_of(old)].next.load(memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack(next, tag_of(old) + 1), memory_order_acquire, memory_order_acquire))
+                return index_of(old);
+        }
+        return NIL;
+    }
+
+    // One attempt: NIL + contended = true if we lost a race, NIL + contended = false if empty
+    uint32_t try_pop(Node nodes[], bool &contended) {
+        uint64_t old = head.load(memory_order_acquire);
+        contended = false;
+        if (index_of(old) == NIL) return NIL;
+        uint32_t next = nodes[index_of(old)].next.load(memory_order_relaxed);
+        if (head.compare_exchange_strong(old, pack(next, tag_of(old) + 1), memory_order_acquire, memory_order_acquire))
+            return index_of(old);
+        contended = true;
+        return NIL;
+    }
+
+private:
+    static uint64_t pack(uint32_t idx, uint32_t tag) { return ((uint64_t)tag << 32) | idx; }
+    static uint32_t index_of(uint64_t h) { return (uint32_t)h; }
+    static uint32_t tag_of(uint64_t h) { return (uint32_t)(h >> 32); }
+
+    alignas(64) atomic<uint64_t> head;
+};
+
+// ---------------- Elimination array ----------------
+
+// Under contention a push and a pop can cancel each other out in a side slot
+// instead of both fighting over the head. Slot = (state << 32) | value.
+
+const uint64_t SLOT_EMPTY = 0;
+const uint64_t SLOT_OFFER = 1;
+const uint64_t SLOT_TAKEN = 2;
+const int ELIM_SLOTS = 16;
+const int ELIM_SPINS = 64;
+
+struct alignas(64) Slot {
+    atomic<uint64_t> word{SLOT_EMPTY << 32};
+};
+
+uint32_t next_random() {
+    thread_local uint32_t x = 2463534242u ^ (uint32_t)hash<thread::id>()(this_thread::get_id());
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// ---------------- Bounded stack ----------------
+
+class LockFreeStack {
+public:
+    LockFreeStack(int capacity, bool elimination) : nodes(new Node[capacity]), use_elimination(elimination) {
+        for (int i = capacity - 1; i >= 0; i--)
+            free_list.push(nodes, i); // every node starts on the free list
+    }
+
+    ~LockFreeStack() { delete[] nodes; }
+
+    // Returns false if the stack is full
+    bool push(int value) {
+        uint32_t idx = free_list.pop(nodes);
+        if (idx == NIL) return false;
+        nodes[idx].value = value;
+
+        if (!use_elimination) {
+            items.push(nodes, idx);
+            return true;
+        }
+        while (!items.try_push(nodes, idx)) {
+            if (eliminate_push(value)) {
+                free_list.push(nodes, idx); // a pop took the value directly, node not needed
+                return true;
+            }
+        }
+        return true;
+    }
+
+    // Returns false if the stack is empty
+    bool pop(int &value) {
+        if (!use_elimination) {
+            uint32_t idx = items.pop(nodes);
+            if (idx == NIL) return false;
+            value = nodes[idx].value;
+            free_list.push(nodes, idx);
+            return true;
+        }
+        while (true) {
+            bool contended;
+            uint32_t idx = items.try_pop(nodes, contended);
+            if (idx != NIL) {
+                value = nodes[idx].value;
+                free_list.push(nodes, idx);
+                return true;
+            }
+            if (!contended) return false; // really empty
+            if (eliminate_pop(value)) return true;
+        }
+    }
+
+private:
+    // Offer the value in a random slot and wait a little for a pop to take it
+    bool eliminate_push(int value) {
+        Slot &s = slots[next_random() % ELIM_SLOTS];
+        uint64_t expected = SLOT_EMPTY << 32;
+        uint64_t offer = (SLOT_OFFER << 32) | (uint32_t)value;
+        if (!s.word.compare_exchange_strong(expected, offer, memory_order_acq_rel)) return false;
+
+        for (int i = 0; i < ELIM_SPINS; i++) {
+            if ((s.word.load(memory_order_acquire) >> 32) == SLOT_TAKEN) {
+                s.word.store(SLOT_EMPTY << 32, memory_order_release);
+                return true;
+            }
+        }
+        // Withdraw the offer; if that fails a pop took it just now
+        expected = offer;
+        if (s.word.compare_exchange_strong(expected, SLOT_EMPTY << 32, memory_order_acq_rel)) return false;
+        s.word.store(SLOT_EMPTY << 32, memory_order_release);
+        return true;
+    }
+
+    bool eliminate_pop(int &value) {
+        Slot &s = slots[next_random() % ELIM_SLOTS];
+        uint64_t w = s.word.load(memory_order_acquire);
+        if ((w >> 32) != SLOT_OFFER) return false;
+        if (!s.word.compare_exchange_strong(w, SLOT_TAKEN << 32, memory_order_acq_rel)) return false;
+        value = (int)(uint32_t)w;
+        return true;
+    }
+
+    Node *nodes;
+    IndexStack items;     // nodes holding values (the LIFO buffer)
+    IndexStack free_list; // unused nodes
+    bool use_elimination;
+    Slot slots[ELIM_SLOTS];
+};
+
+// ---------------- Baseline: mutex + vector ----------------
+
+class MutexStack {
+public:
+    MutexStack(int capacity) : capacity(capacity) { data.reserve(capacity); }
+
+    bool push(int value) {
+        lock_guard<mutex> lock(mtx);
+        if ((int)data.size() == capacity) return false;
+        data.push_back(value);
+        return true;
+    }
+
+    bool pop(int &value) {
+        lock_guard<mutex> lock(mtx);
+        if (data.empty()) return false;
+        value = data.back();
+        data.pop_back();
+        return true;
+    }
+
+private:
+    mutex mtx;
+    vector<int> data;
+    int capacity;
+};
+
+// ---------------- Producer / Consumer (ProducerConsumer.cpp without the race) ----------------
+
+void producer_consumer_demo() {
+    LockFreeStack buffer(10, false);
+
+    thread producer([&] {
+        for (int i = 1; i <= 10; i++) {
+            while (!buffer.push(i)) this_thread::yield(); // full -> retry
+            cout << "Produced: " << i << endl;
+        }
+    });
+
+    thread consumer([&] {
+        int consumed = 0;
+        while (consumed < 10) {
+            int val;
+            if (buffer.pop(val)) {
+                cout << "Consumed: " << val << endl;
+                consumed++;
+            } else {
+                this_thread::yield();
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+}
+
+// ---------------- Benchmark ----------------
+
+const int CAPACITY = 1024;
+
+// Every thread pops a value and pushes it back (LIFO reuse). The multiset of values
+// in the stack never changes, so the final sum tells us whether anything got lost.
+
+template <typename Stack>
+void bench(const char *name, int num_threads, int ops_per_thread) {
+    Stack stack(CAPACITY);
+    long long expected = 0;
+    for (int i = 0; i < CAPACITY / 2; i++) {
+        stack.push(i);
+        expected += i;
+    }
+
+    atomic<bool> go(false);
+    vector<thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&] {
+            while (!go.load()) this_thread::yield();
+            for (int i = 0; i < ops_per_thread; i++) {
+                int v;
+                if (stack.pop(v)) stack.push(v);
+            }
+        });
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    go = true;
+    for (auto &th : threads) th.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    long long total = 0;
+    int v;
+    while (stack.pop(v)) total += v;
+
+    double mops = 2.0 * num_threads * ops_per_thread / secs / 1e6;
+    cout << left << setw(22) << name << right << setw(8) << num_threads
+         << fixed << setprecision(2) << setw(12) << mops
+         << (total == expected ? "      ok" : "      LOST VALUES") << endl;
+}
+
+// Adapters so bench() can build every stack from a capacity
+
+struct TreiberStack : LockFreeStack {
+    TreiberStack(int capacity) : LockFreeStack(capacity, false) {}
+};
+
+struct EliminationStack : LockFreeStack {
+    EliminationStack(int capacity) : LockFreeStack(capacity, true) {}
+};
+
+int main(int argc, char *argv[]) {
+    int ops = argc > 1 ? atoi(argv[1]) : 200000;
+    int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+
+    cout << "--- Producer / Consumer with lock-free LIFO buffer ---" << endl;
+    producer_consumer_demo();
+
+    cout << "\n--- Throughput (pop + push pairs) ---" << endl;
+    cout << left << setw(22) << "Stack" << right << setw(8) << "Threads" << setw(12) << "Mops/sec" << endl;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        bench<MutexStack>("mutex + vector", threads, ops);
+        bench<TreiberStack>("treiber (tagged)", threads, ops);
+        bench<EliminationStack>("treiber + elimination", threads, ops);
+        cout << endl;
+    }
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -pthread LockFreeStack.cpp -o /tmp/LockFreeStack
+Run:     /tmp/LockFreeStack [ops per thread] [max threads]
+
+ABA problem:
+  T1 reads head = A (next = B) and gets preempted.
+  T2 pops A, pops B, pushes A back.  head = A again, but A->next is no longer B.
+  T1's CAS(head: A -> B) would succeed and put the freed node B back on top.
+The 32-bit tag packed next to the index changes on every update, so T1's CAS fails.
+
+Elimination backoff: when the CAS on head fails, a push parks its value in a random slot
+for a short time; a pop that also failed can grab it from there. Both finish without
+touching the head at all, which helps most at high thread counts.
+*/
@@ -0,0 +1,206 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cstdlib>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Parallel prefix sum (inclusive / exclusive scan) and parallel top-k.
+// Both split the array the same way as sumOfArrayMultithread.cpp / minMax.cpp,
+// generalized from 2 halves to N parts: part t = [n*t/N, n*(t+1)/N).
+
+long long part_start(long long n, int t, int num_threads) { return n * t / num_threads; }
+long long part_end(long long n, int t, int num_threads) { return n * (t + 1) / num_threads; }
+
+// ---------------- Scan ----------------
+
+// Scan arr[start..end) into out[], starting from 'carry' (sum of everything before start).
+// inclusive: out[i] = arr[0] + ... + arr[i]
+// exclusive: out[i] = arr[0] + ... + arr[i-1]
+
+void scan_block(const int arr[], long long out[], long long start, long long end, long long carry, bool inclusive) {
+    long long i = start;
+
+#if defined(__AVX2__)
+    // 4 values per step: widen to 64-bit, scan inside the register, add running carry
+    __m256i zero = _mm256_setzero_si256();
+    __m256i run = _mm256_set1_epi64x(carry);
+    for (; i + 4 <= end; i += 4) {
+        __m256i x = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(arr + i)));
+        __m256i s = x;
+        // s += s shifted up by one lane, then by two lanes (Hillis-Steele inside the vector)
+        s = _mm256_add_epi64(s, _mm256_blend_epi32(_mm256_permute4x64_epi64(s, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+        s = _mm256_add_epi64(s, _mm256_blend_epi32(_mm256_permute4x64_epi64(s, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F));
+        s = _mm256_add_epi64(s, run);
+        __m256i result = inclusive ? s : _mm256_sub_epi64(s, x);
+        _mm256_storeu_si256((__m256i *)(out + i), result);
+        run = _mm256_permute4x64_epi64(s, _MM_SHUFFLE(3, 3, 3, 3)); // broadcast last lane
+    }
+    if (i > start) carry = out[i - 1] + (inclusive ? 0 : arr[i - 1]);
+#endif
+
+    for (; i < end; i++) { // scalar path / leftover tail
+        if (inclusive) {
+            carry += arr[i];
+            out[i] = carry;
+        } else {
+            out[i] = carry;
+            carry += arr[i];
+        }
+    }
+}
+
+void chunk_sum(const int arr[], long long start, long long end, long long &result) {
+    long long s = 0;
+    for (long long i = start; i < end; i++)
+        s += arr[i];
+    result = s;
+}
+
+// Two-pass blocked scan:
+//   pass 1: every thread sums its own part
+//   (main)  exclusive scan of the N part sums -> starting carry of every part
+//   pass 2: every thread scans its own part starting from its carry
+
+void parallel_scan(const int arr[], long long out[], long long n, int num_threads, bool inclusive) {
+    vector<long long> sums(num_threads), carry(num_threads);
+    vector<thread> threads;
+
+    for (int t = 0; t < num_threads; t++)
+        threads.emplace_back(chunk_sum, arr, part_start(n, t, num_threads), part_end(n, t, num_threads), ref(sums[t]));
+    for (auto &th : threads) th.join();
+    threads.clear();
+
+    long long running = 0;
+    for (int t = 0; t < num_threads; t++) {
+        carry[t] = running;
+        running += sums[t];
+    }
+
+    for (int t = 0; t < num_threads; t++)
+        threads.emplace_back(scan_block, arr, out, part_start(n, t, num_threads), part_end(n, t, num_threads), carry[t], inclusive);
+    for (auto &th : threads) th.join();
+}
+
+// ---------------- Top-k ----------------
+
+// Each thread keeps the k largest values of its part in a bounded min-heap:
+// the root is the smallest of the current top-k, so a new value only enters if it beats the root.
+
+void partial_topk(const int arr[], long long start, long long end, int k, vector<int> &result) {
+    priority_queue<int, vector<int>, greater<int>> heap;
+    for (long long i = start; i < end; i++) {
+        if ((int)heap.size() < k) {
+            heap.push(arr[i]);
+        } else if (arr[i] > heap.top()) {
+            heap.pop();
+            heap.push(arr[i]);
+        }
+    }
+    result.clear();
+    while (!heap.empty()) {
+        result.push_back(heap.top());
+        heap.pop();
+    }
+}
+
+// Returns the k largest values in descending order; result[k-1] is the k-th largest (nth element)
+
+vector<int> parallel_topk(const int arr[], long long n, int k, int num_threads) {
+    vector<vector<int>> parts(num_threads);
+    vector<thread> threads;
+
+    for (int t = 0; t < num_threads; t++)
+        threads.emplace_back(partial_topk, arr, part_start(n, t, num_threads), part_end(n, t, num_threads), k, ref(parts[t]));
+    for (auto &th : threads) th.join();
+
+    // Merge: at most N*k candidates, keep the k largest
+    vector<int> all;
+    for (auto &p : parts) all.insert(all.end(), p.begin(), p.end());
+    int keep = min<long long>(k, all.size());
+    partial_sort(all.begin(), all.begin() + keep, all.end(), greater<int>());
+    all.resize(keep);
+    return all;
+}
+
+int main(int argc, char *argv[]) {
+    long long n = argc > 1 ? atoll(argv[1]) : 1 << 24;
+    int num_threads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    int k = argc > 3 ? atoi(argv[3]) : 10;
+    if (num_threads < 1) num_threads = 1;
+    if (k < 1) k = 1;
+    if (n < 1) {
+        cerr << "n must be at least 1!" << endl;
+        exit(1);
+    }
+    if (k > n) {
+        cerr << "k = " << k << " is larger than n, using k = " << n << endl;
+        k = (int)n;
+    }
+
+    vector<int> arr(n);
+    srand(7);
+    for (long long i = 0; i < n; i++)
+        arr[i] = rand() % 2000001 - 1000000;
+
+    vector<long long> incl(n), excl(n);
+
+    auto t0 = chrono::steady_clock::now();
+    parallel_scan(arr.data(), incl.data(), n, num_threads, true);
+    auto t1 = chrono::steady_clock::now();
+    parallel_scan(arr.data(), excl.data(), n, num_threads, false);
+    auto t2 = chrono::steady_clock::now();
+    vector<int> top = parallel_topk(arr.data(), n, k, num_threads);
+    auto t3 = chrono::steady_clock::now();
+
+    // Check against simple sequential versions
+    bool scan_ok = true;
+    long long running = 0;
+    for (long long i = 0; i < n && scan_ok; i++) {
+        if (excl[i] != running) scan_ok = false;
+        running += arr[i];
+        if (incl[i] != running) scan_ok = false;
+    }
+
+    vector<int> sorted_copy(arr);
+    sort(sorted_copy.begin(), sorted_copy.end(), greater<int>());
+    bool topk_ok = equal(top.begin(), top.end(), sorted_copy.begin());
+
+    auto ms = [](chrono::steady_clock::time_point a, chrono::steady_clock::time_point b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+
+    cout << "Elements: " << n << ", threads: " << num_threads << ", k: " << k << endl;
+    cout << "Total sum        = " << incl[n - 1] << endl;
+    cout << "Inclusive scan   : " << ms(t0, t1) << " ms" << endl;
+    cout << "Exclusive scan   : " << ms(t1, t2) << " ms" << endl;
+    cout << "Scans correct    : " << (scan_ok ? "yes" : "NO") << endl;
+    cout << "Top-" << k << "           : ";
+    for (int v : top) cout << v << " ";
+    cout << endl;
+    cout << k << "-th largest     = " << top.back() << endl;
+    cout << "Top-k time       : " << ms(t2, t3) << " ms" << endl;
+    cout << "Top-k correct    : " << (topk_ok ? "yes" : "NO") << endl;
+
+    return 0;
+}
+
+/*
+Compile: g++ -O3 -march=native -pthread scanTopK.cpp -o /tmp/scanTopK
+Run:     /tmp/scanTopK [n] [threads] [k]
+
+Why two passes for scan?
+Part t cannot start until it knows the sum of parts 0..t-1. Pass 1 finds every part's
+sum in parallel, the main thread turns those N numbers into starting offsets, and pass 2
+scans all parts in parallel. Inside a part AVX2 scans 4 values per step
+(without AVX2 the scalar loop is used).
+
+Top-k: per-thread min-heap of size k -> O(n log k) work, only N*k values to merge.
+*/
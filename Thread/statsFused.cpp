@@ -0,0 +1,200 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+// Fused statistics: min, max, sum, count, mean and variance in ONE pass
+// over the array, instead of one pass for maximum() and another for partial_sum().
+
+struct Stats {
+    long long count = 0;
+    int min = INT_MAX;
+    int max = INT_MIN;
+    long long sum = 0;
+    double mean = 0.0;
+    double m2 = 0.0; // sum of squared differences from the mean
+
+    double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+};
+
+// Combine two partial states (Chan et al. pairwise update).
+// count/min/max/sum merge exactly; mean and m2 stay numerically stable.
+
+Stats merge(const Stats &a, const Stats &b) {
+    if (a.count == 0) return b;
+    if (b.count == 0) return a;
+
+    Stats r;
+    r.count = a.count + b.count;
+    r.min = a.min < b.min ? a.min : b.min;
+    r.max = a.max > b.max ? a.max : b.max;
+    r.sum = a.sum + b.sum;
+
+    double delta = b.mean - a.mean;
+    r.mean = (double)r.sum / r.count;
+    r.m2 = a.m2 + b.m2 + delta * delta * ((double)a.count * b.count / r.count);
+    return r;
+}
+
+// Block small enough that its shifted sums never lose precision
+
+const int BLOCK = 2048;
+
+const int LANES = 8;
+
+Stats block_stats(const int arr[], int start, int end) {
+    int mn[LANES], mx[LANES];
+    long long s[LANES];
+    double sq[LANES];
+    int shift = arr[start]; // shifted data: squares stay small, no cancellation
+
+    for (int k = 0; k < LANES; k++) {
+        mn[k] = INT_MAX;
+        mx[k] = INT_MIN;
+        s[k] = 0;
+        sq[k] = 0.0;
+    }
+
+    // Independent lanes -> compiler can keep min/max/sum/squares in SIMD registers
+    // (a single double accumulator would force strict left-to-right additions)
+    int i = start;
+    for (; i + LANES <= end; i += LANES) {
+        for (int k = 0; k < LANES; k++) {
+            int v = arr[i + k];
+            mn[k] = v < mn[k] ? v : mn[k];
+            mx[k] = v > mx[k] ? v : mx[k];
+            s[k] += v;
+            double d = (double)v - shift;
+            sq[k] += d * d;
+        }
+    }
+    for (; i < end; i++) { // leftover tail
+        int v = arr[i];
+        mn[0] = v < mn[0] ? v : mn[0];
+        mx[0] = v > mx[0] ? v : mx[0];
+        s[0] += v;
+        double d = (double)v - shift;
+        sq[0] += d * d;
+    }
+
+    for (int k = 1; k < LANES; k++) {
+        mn[0] = mn[k] < mn[0] ? mn[k] : mn[0];
+        mx[0] = mx[k] > mx[0] ? mx[k] : mx[0];
+        s[0] += s[k];
+        sq[0] += sq[k];
+    }
+
+    Stats b;
+    b.count = end - start;
+    b.min = mn[0];
+    b.max = mx[0];
+    b.sum = s[0];
+    b.mean = (double)s[0] / b.count;
+
+    // M2 = sum((v - shift)^2) - count * (mean - shift)^2
+    double dm = b.mean - shift;
+    b.m2 = sq[0] - b.count * dm * dm;
+    if (b.m2 < 0) b.m2 = 0;
+    return b;
+}
+
+// Thread function: fused statistics for arr[start..end)
+
+void partial_stats(const int arr[], int start, int end, Stats &result) {
+    Stats acc;
+    for (int i = start; i < end; i += BLOCK) {
+        int stop = i + BLOCK < end ? i + BLOCK : end;
+        acc = merge(acc, block_stats(arr, i, stop));
+    }
+    result = acc;
+}
+
+// Same shape as partial_sum() in sumOfArrayMultithread.cpp, used as the baseline
+
+void partial_sum(const int arr[], int start, int end, long long &result) {
+    long long s = 0;
+    for (int i = start; i < end; i++) {
+        s += arr[i];
+    }
+    result = s;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : 1 << 24;
+    int num_threads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    if (num_threads < 1) num_threads = 1;
+
+    vector<int> arr(n);
+    srand(42);
+    for (int i = 0; i < n; i++)
+        arr[i] = rand() % 1000000 - 500000;
+
+    // Split array into num_threads equal parts (generalized n/2 split)
+
+    vector<Stats> parts(num_threads);
+    vector<long long> sums(num_threads);
+    vector<thread> threads;
+
+    auto t0 = chrono::steady_clock::now();
+    for (int t = 0; t < num_threads; t++) {
+        int start = (long long)n * t / num_threads;
+        int end = (long long)n * (t + 1) / num_threads;
+        threads.emplace_back(partial_stats, arr.data(), start, end, ref(parts[t]));
+    }
+    for (auto &th : threads) th.join();
+    threads.clear();
+
+    Stats total;
+    for (auto &p : parts) total = merge(total, p);
+    auto t1 = chrono::steady_clock::now();
+
+    for (int t = 0; t < num_threads; t++) {
+        int start = (long long)n * t / num_threads;
+        int end = (long long)n * (t + 1) / num_threads;
+        threads.emplace_back(partial_sum, arr.data(), start, end, ref(sums[t]));
+    }
+    for (auto &th : threads) th.join();
+
+    long long total_sum = 0;
+    for (long long s : sums) total_sum += s;
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "Count    = " << total.count << endl;
+    cout << "Minimum  = " << total.min << endl;
+    cout << "Maximum  = " << total.max << endl;
+    cout << "Sum      = " << total.sum << (total.sum == total_sum ? " (matches partial_sum)" : " (MISMATCH)") << endl;
+    cout << "Mean     = " << total.mean << endl;
+    cout << "Variance = " << total.variance() << endl;
+    cout << "Std dev  = " << sqrt(total.variance()) << endl;
+
+    double fused_ms = chrono::duration<double, milli>(t1 - t0).count();
+    double sum_ms = chrono::duration<double, milli>(t2 - t1).count();
+    cout << "\nThreads: " << num_threads << endl;
+    cout << "Fused stats pass: " << fused_ms << " ms" << endl;
+    cout << "partial_sum pass: " << sum_ms << " ms" << endl;
+
+    return 0;
+}
+
+/*
+Compile: g++ -O3 -march=native -pthread statsFused.cpp -o /tmp/statsFused
+Run:     /tmp/statsFused [n] [threads]
+
+Why blocks?
+Welford's update (mean += d / count) has a division per element and a loop-carried
+dependency, so it cannot be vectorized. Instead each 2048-element block is read once
+by a min/max/sum/sum-of-squares loop that the compiler turns into SIMD. Squares are
+taken relative to the block's first element (shifted data), which avoids the classic
+cancellation of sum(x^2) - n*mean^2. Blocks are then merged with Chan's formula:
+
+    delta = meanB - meanA
+    M2    = M2A + M2B + delta^2 * nA * nB / (nA + nB)
+
+The same merge combines per-thread results, so the answer does not depend on how
+the array was split. Memory is only streamed once -> about the cost of partial_sum().
+*/
@@ -1,11 +1,13 @@
 #include <iostream>
 #include <thread>
+#include "PerfRegion.h"
 using namespace std;
 
 // Thread function to compute partial sum
 
 void partial_sum(int arr[], int start, int end, int &result) {
     
+    PerfRegion region("partial_sum"); // counters only with PERF_JSON set
     result = 0;
     
     for (int i = start; i < end; i++) {
@@ -36,3 +38,9 @@ int main() {
 
     return 0;
 }
+
+/*
+Compile: g++ -O2 -pthread sumOfArrayMultithread.cpp -o /tmp/sumOfArrayMultithread
+Run:     /tmp/sumOfArrayMultithread
+Measure: PERF_JSON=- /tmp/sumOfArrayMultithread      (cycles, instructions, misses per thread, see PerfRegion.h)
+*/
@@ -0,0 +1,259 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <dirent.h>
+
+using namespace std;
+
+// CPU affinity + NUMA-aware partitioning for the parallel sum and the parallel sort.
+// Topology is read straight from /sys, no libnuma needed, and limited to the CPUs this
+// process may run on (taskset, cgroup cpuset).
+
+struct Topology {
+    vector<vector<int>> node_cpus; // node_cpus[node] = list of CPU ids on that node
+};
+
+// Parse a kernel cpulist such as "0-3,8-11,16"
+
+vector<int> parse_cpulist(const string &text) {
+    vector<int> cpus;
+    stringstream ss(text);
+    string part;
+    while (getline(ss, part, ',')) {
+        if (part.empty() || part == "\n") continue;
+        int lo = 0, hi = 0;
+        if (sscanf(part.c_str(), "%d-%d", &lo, &hi) == 2) {
+            for (int c = lo; c <= hi; c++) cpus.push_back(c);
+        } else if (sscanf(part.c_str(), "%d", &lo) == 1) {
+            cpus.push_back(lo);
+        }
+    }
+    return cpus;
+}
+
+string read_file(const string &path) {
+    ifstream in(path);
+    string text;
+    getline(in, text);
+    return text;
+}
+
+Topology read_topology() {
+    Topology topo;
+
+    // CPUs we are allowed to use; the cgroup cpuset is already applied to this mask
+    cpu_set_t allowed;
+    bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    auto usable = [&](vector<int> cpus) {
+        if (!have_mask) return cpus;
+        vector<int> out;
+        for (int c : cpus)
+            if (c < CPU_SETSIZE && CPU_ISSET(c, &allowed)) out.push_back(c);
+        return out;
+    };
+
+    DIR *dir = opendir("/sys/devices/system/node");
+    if (dir) {
+        vector<int> nodes;
+        while (dirent *e = readdir(dir)) {
+            int id;
+            if (sscanf(e->d_name, "node%d", &id) == 1) nodes.push_back(id);
+        }
+        closedir(dir);
+        sort(nodes.begin(), nodes.end());
+
+        for (int id : nodes) {
+            vector<int> cpus = usable(parse_cpulist(read_file("/sys/devices/system/node/node" + to_string(id) + "/cpulist")));
+            if (!cpus.empty()) topo.node_cpus.push_back(cpus); // skip memory-only nodes and nodes we may not use
+        }
+    }
+
+    // No NUMA info (or no CPUs listed) -> treat the machine as one node
+    if (topo.node_cpus.empty()) {
+        vector<int> cpus = usable(parse_cpulist(read_file("/sys/devices/system/cpu/online")));
+        if (cpus.empty() && have_mask) {
+            for (int c = 0; c < CPU_SETSIZE; c++)
+                if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+        }
+        if (cpus.empty()) {
+            for (unsigned c = 0; c < thread::hardware_concurrency(); c++) cpus.push_back(c);
+        }
+        topo.node_cpus.push_back(cpus);
+    }
+    return topo;
+}
+
+// Placement policy
+
+enum Placement { UNPINNED, PINNED };
+
+// Pick a CPU for worker t: walk the CPUs node by node and spread workers evenly,
+// so contiguous partitions (worker 0, 1, ...) land on the same node.
+
+int cpu_for_worker(const Topology &topo, int t, int num_threads) {
+    vector<int> all;
+    for (auto &cpus : topo.node_cpus) all.insert(all.end(), cpus.begin(), cpus.end());
+    return all[(long long)t * all.size() / num_threads];
+}
+
+atomic<int> pin_failures{0}; // threads of the current run that could not be pinned
+
+void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); // returns the error, no errno
+    if (err) {
+        if (pin_failures++ == 0) cerr << "pthread_setaffinity_np(CPU " << cpu << ") failed: " << strerror(err) << endl;
+    }
+}
+
+// Worker data, like ThreadData in sumOfArrayStructure.cpp
+
+struct Worker {
+    int *array;
+    long long start;
+    long long end;
+    int cpu;          // -1 = no pinning
+    long long result;
+};
+
+// First touch: the page is placed on the node of the thread that writes it first
+
+void init_part(Worker *w) {
+    if (w->cpu >= 0) pin_to_cpu(w->cpu);
+    for (long long i = w->start; i < w->end; i++)
+        w->array[i] = (int)((i * 2654435761u) % 1000);
+}
+
+void partial_sum(Worker *w) {
+    if (w->cpu >= 0) pin_to_cpu(w->cpu);
+    long long s = 0;
+    for (long long i = w->start; i < w->end; i++)
+        s += w->array[i];
+    w->result = s;
+}
+
+void sort_part(Worker *w) {
+    if (w->cpu >= 0) pin_to_cpu(w->cpu);
+    sort(w->array + w->start, w->array + w->end);
+}
+
+template <typename F>
+void run_workers(vector<Worker> &workers, F fn) {
+    vector<thread> threads;
+    for (auto &w : workers) threads.emplace_back(fn, &w);
+    for (auto &th : threads) th.join();
+}
+
+void run(const Topology &topo, Placement policy, long long n, int num_threads) {
+    // mmap'ed memory is not touched yet -> placement decided by init_part()
+    int *array = (int *)mmap(NULL, n * sizeof(int), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (array == MAP_FAILED) {
+        cerr << "mmap failed!" << endl;
+        exit(1);
+    }
+
+    vector<Worker> workers(num_threads);
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].array = array;
+        workers[t].start = n * t / num_threads;
+        workers[t].end = n * (t + 1) / num_threads;
+        workers[t].cpu = policy == PINNED ? cpu_for_worker(topo, t, num_threads) : -1;
+        workers[t].result = 0;
+    }
+
+    pin_failures = 0;
+    auto t0 = chrono::steady_clock::now();
+    if (policy == PINNED) {
+        run_workers(workers, init_part);
+    } else {
+        Worker all {array, 0, n, -1, 0}; // baseline: main thread touches everything
+        init_part(&all);
+    }
+    auto t1 = chrono::steady_clock::now();
+
+    long long total = 0;
+    for (int rep = 0; rep < 5; rep++) {
+        run_workers(workers, partial_sum);
+    }
+    for (auto &w : workers) total += w.result;
+    auto t2 = chrono::steady_clock::now();
+
+    run_workers(workers, sort_part);
+    auto t3 = chrono::steady_clock::now();
+
+    // Merge sorted parts pairwise (same idea as sort.cpp, for N parts)
+    vector<int> merged(array, array + n);
+    for (long long width = 1; width < num_threads; width *= 2) {
+        for (long long t = 0; t + width < num_threads; t += 2 * width) {
+            long long lo = workers[t].start;
+            long long mid = workers[t + width].start;
+            long long hi = workers[min<long long>(t + 2 * width, num_threads) - 1].end;
+            inplace_merge(merged.begin() + lo, merged.begin() + mid, merged.begin() + hi);
+        }
+    }
+    auto t4 = chrono::steady_clock::now();
+
+    auto ms = [](chrono::steady_clock::time_point a, chrono::steady_clock::time_point b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+
+    cout << (policy == UNPINNED ? "unpinned" : pin_failures ? "NOT pinned" : "pinned  ")
+         << "\tinit " << ms(t0, t1) << " ms"
+         << "\tsum x5 " << ms(t1, t2) << " ms"
+         << "\tsort parts " << ms(t2, t3) << " ms"
+         << "\tmerge " << ms(t3, t4) << " ms"
+         << "\t(sum = " << total / 5 << ", sorted = " << (is_sorted(merged.begin(), merged.end()) ? "yes" : "NO") << ")";
+    if (pin_failures) cout << "\t[" << pin_failures << " pin calls failed]";
+    cout << endl;
+
+    munmap(array, n * sizeof(int));
+}
+
+int main(int argc, char *argv[]) {
+    long long n = argc > 1 ? atoll(argv[1]) : 1 << 24;
+    int num_threads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    if (num_threads < 1) num_threads = 1;
+
+    Topology topo = read_topology();
+
+    cout << "NUMA nodes (allowed CPUs only): " << topo.node_cpus.size() << endl;
+    for (size_t i = 0; i < topo.node_cpus.size(); i++) {
+        cout << "  node " << i << ": " << topo.node_cpus[i].size() << " CPUs (";
+        for (size_t j = 0; j < topo.node_cpus[i].size(); j++)
+            cout << (j ? "," : "") << topo.node_cpus[i][j];
+        cout << ")" << endl;
+    }
+    cout << "Elements: " << n << ", threads: " << num_threads << "\n" << endl;
+
+    run(topo, UNPINNED, n, num_threads);
+    run(topo, PINNED, n, num_threads);
+
+    return 0;
+}
+
+/*
+Compile: g++ -O2 -pthread threadAffinity.cpp -o /tmp/threadAffinity
+Run:     /tmp/threadAffinity [n] [threads]
+
+pthread_setaffinity_np() -> restrict a thread to a set of CPUs (no migration mid-run)
+First-touch policy       -> Linux allocates a physical page on the node of the CPU that
+                            first writes it, so each worker initializes its own partition.
+UNPINNED baseline        -> main thread initializes everything (all pages on one node),
+                            workers float between CPUs.
+
+On a single-node machine both runs use the same memory; pinning only removes migrations.
+Linux only (pthread_setaffinity_np / sysfs).
+*/
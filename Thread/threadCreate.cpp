@@ -1,6 +1,7 @@
 #include <iostream>
 #include <thread>
 #include <unistd.h> // for sleep
+#include "../Synchronization/VirtualTime.h" // VT_SEED / VT_SWEEP: deterministic virtual time
 
 using namespace std;
 
@@ -10,14 +11,14 @@ void thread_fun() {
     
     for (int j = 0; j < 5; j++) {
         cout << j << endl;
-        sleep(1);
+        vt::sleep(1);
     }
 }
 
 int main() {
     // create a thread
     
-    thread t1(thread_fun);
+    vt::thread t1(thread_fun);
 
     // wait for the thread to finish
     
@@ -27,7 +28,7 @@ int main() {
     
     for (int i = 15; i < 20; i++) {
         cout << i << endl;
-        sleep(1);
+        vt::sleep(1);
     }
 
     return 0;